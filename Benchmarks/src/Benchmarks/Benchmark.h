@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+    class Scene;
+}
+
+namespace Titan::Benchmarks
+{
+    /// @brief Prints the mean time of one iteration, and per item when there is more than one
+    inline void PrintResult(std::string_view name, double microsecondsPerIteration, uint32_t unitsPerIteration)
+    {
+        if (unitsPerIteration > 1)
+            fmt::print("  {:<44} {:>12.2f} us  {:>10.1f} ns/item\n", name, microsecondsPerIteration,
+                       microsecondsPerIteration * 1000.0 / unitsPerIteration);
+        else
+            fmt::print("  {:<44} {:>12.2f} us\n", name, microsecondsPerIteration);
+    }
+
+    /// @brief Runs function once to warm up, then iterations times, and prints the mean time of one iteration
+    /// @param unitsPerIteration work items per iteration (jobs, entities), also printed per item when above one
+    template <typename Function>
+    void Run(std::string_view name, uint32_t iterations, uint32_t unitsPerIteration, Function&& function)
+    {
+        function();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++)
+            function();
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        PrintResult(name, elapsed.count() / iterations, unitsPerIteration);
+    }
+
+    /// @brief Like Run, but calls setup before every iteration and leaves it out of the time
+    template <typename Setup, typename Function>
+    void RunWithSetup(std::string_view name, uint32_t iterations, uint32_t unitsPerIteration, Setup&& setup,
+                      Function&& function)
+    {
+        setup();
+        function();
+
+        std::chrono::steady_clock::duration elapsed{};
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        PrintResult(name, std::chrono::duration<double, std::micro>(elapsed).count() / iterations,
+                    unitsPerIteration);
+    }
+
+    /// @brief Keeps the compiler from dropping a computed value
+    template <typename T>
+    void DoNotOptimize(const T& value)
+    {
+        static const void* volatile s_Sink;
+        s_Sink = &value;
+    }
+
+    void RunJobSystemBenchmarks();
+    void RunDynamicBVHBenchmarks();
+    void RunMeshBenchmarks();
+    void RunTransformBenchmarks();
+    void RunSceneBenchmarks();
+
+    /// @brief Entities with random transforms and sprites, parented into a hierarchy of ten children per parent
+    Ref<Scene> CreateHierarchyScene(uint32_t entityCount);
+} // namespace Titan::Benchmarks
@@ -0,0 +1,41 @@
+#include <random>
+#include <Titan/Scene/Components.h>
+#include <Titan/Scene/Entity.h>
+#include <Titan/Scene/Scene.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    // Every entity after the roots is a child of an earlier one, ten children per parent. At 100k entities that
+    // is three levels deep.
+    static constexpr uint32_t s_RootCount = 1000;
+    static constexpr uint32_t s_ChildrenPerParent = 10;
+
+    Ref<Scene> CreateHierarchyScene(uint32_t entityCount)
+    {
+        Ref<Scene> scene = CreateRef<Scene>();
+        std::mt19937 random(entityCount);
+        std::uniform_real_distribution<float> offset(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<Entity> entities;
+        entities.reserve(entityCount);
+        for (uint32_t i = 0; i < entityCount; i++)
+        {
+            Entity entity = scene->CreateEntity(fmt::format("Entity {}", i));
+            auto& tc = entity.GetComponent<TransformComponent>();
+            tc.Translation = {offset(random), offset(random), offset(random)};
+            tc.Rotation = {0.0f, 0.0f, unit(random) * glm::two_pi<float>()};
+            entity.AddComponent<SpriteRendererComponent>().Color = {unit(random), unit(random), unit(random), 1.0f};
+
+            if (i >= s_RootCount)
+            {
+                Entity parent = entities[i / s_ChildrenPerParent];
+                entity.GetComponent<RelationshipComponent>().Parent = parent.GetUUID();
+                parent.GetComponent<RelationshipComponent>().Children.push_back(entity.GetUUID());
+            }
+            entities.push_back(entity);
+        }
+        return scene;
+    }
+} // namespace Titan::Benchmarks
@@ -0,0 +1,49 @@
+#include <Titan/Core/Log.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    struct Suite
+    {
+        std::string_view Name;
+        void (*Run)();
+    };
+
+    static constexpr Suite s_Suites[] = {
+        {"jobs", &RunJobSystemBenchmarks},
+        {"bvh", &RunDynamicBVHBenchmarks},
+        {"mesh", &RunMeshBenchmarks},
+        {"transforms", &RunTransformBenchmarks},
+        {"scene", &RunSceneBenchmarks},
+    };
+
+    static void PrintUsage()
+    {
+        fmt::print("Usage: TitanBenchmarks [all");
+        for (const Suite& suite : s_Suites)
+            fmt::print("|{}", suite.Name);
+        fmt::print("]\n");
+    }
+} // namespace Titan::Benchmarks
+
+// No EntryPoint.h, the benchmarks run without an application
+int main(int argc, char** argv)
+{
+    using namespace Titan::Benchmarks;
+
+    const std::string_view name = argc > 1 ? argv[1] : "all";
+    if (name != "all" && std::ranges::none_of(s_Suites, [&](const Suite& suite) { return suite.Name == name; }))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    Titan::Log::Init();
+
+    for (const Suite& suite : s_Suites)
+    {
+        if (name == "all" || name == suite.Name)
+            suite.Run();
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <cmath>
+#include <random>
+#include <Titan/Scene/DynamicBVH.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    static constexpr uint32_t s_QueryCount = 1000;
+    // Past the fattening margin, so every moved proxy leaves its fat bounds
+    static constexpr float s_MoveDistance = 0.25f;
+
+    // Unit boxes spread through a cube so the density stays the same at every count
+    static std::vector<AABB> CreateBounds(uint32_t count, std::mt19937& random)
+    {
+        const float extent = std::cbrt((float)count) * 4.0f;
+        std::uniform_real_distribution<float> position(0.0f, extent);
+
+        std::vector<AABB> bounds(count);
+        for (AABB& box : bounds)
+        {
+            const glm::vec3 min(position(random), position(random), position(random));
+            box = {min, min + glm::vec3(1.0f)};
+        }
+        return bounds;
+    }
+
+    static void RunMoveBenchmark(DynamicBVH& tree, const std::vector<int32_t>& proxies, std::vector<AABB>& bounds,
+                                 float share)
+    {
+        const uint32_t stride = (uint32_t)(1.0f / share);
+        std::vector<DynamicBVH::ProxyMove> moves;
+        float direction = 1.0f;
+
+        Run(fmt::format("MoveProxies {:.0f}%", share * 100.0f), 10, (uint32_t)(proxies.size() / stride),
+            [&]
+            {
+                // Back and forth, so the tree does not drift between iterations
+                moves.clear();
+                const glm::vec3 offset(s_MoveDistance * direction, 0.0f, 0.0f);
+                for (size_t i = 0; i < proxies.size(); i += stride)
+                {
+                    bounds[i] = {bounds[i].Min + offset, bounds[i].Max + offset};
+                    moves.push_back({proxies[i], bounds[i]});
+                }
+                direction = -direction;
+                tree.MoveProxies(moves);
+            });
+    }
+
+    static void RunQueryBenchmarks(const DynamicBVH& tree, uint32_t count, std::mt19937& random)
+    {
+        const float extent = std::cbrt((float)count) * 4.0f;
+        std::uniform_real_distribution<float> position(0.0f, extent);
+        std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+        std::vector<AABB> boxes(s_QueryCount);
+        for (AABB& box : boxes)
+        {
+            const glm::vec3 min(position(random), position(random), position(random));
+            box = {min, min + glm::vec3(8.0f)};
+        }
+
+        std::vector<Ray> rays(s_QueryCount);
+        for (Ray& ray : rays)
+        {
+            ray.Origin = {position(random), position(random), position(random)};
+            ray.Direction = glm::normalize(glm::vec3(direction(random), direction(random), direction(random)));
+        }
+
+        uint64_t hits = 0;
+        Run("Query 8x8x8 box", 10, s_QueryCount,
+            [&]
+            {
+                for (const AABB& box : boxes)
+                    tree.Query(box, [&hits](uint32_t) { hits++; });
+            });
+
+        Run("RayCast closest hit, 64 units", 10, s_QueryCount,
+            [&]
+            {
+                for (const Ray& ray : rays)
+                {
+                    tree.RayCast(ray, 64.0f,
+                                 [&hits](uint32_t, float distance)
+                                 {
+                                     hits++;
+                                     return distance;
+                                 });
+                }
+            });
+        DoNotOptimize(hits);
+    }
+
+    void RunDynamicBVHBenchmarks()
+    {
+        fmt::print("DynamicBVH\n");
+
+        for (uint32_t count : {10'000u, 100'000u, 1'000'000u})
+        {
+            fmt::print(" {} proxies\n", count);
+
+            std::mt19937 random(count);
+            std::vector<AABB> bounds = CreateBounds(count, random);
+            const uint32_t buildIterations = count >= 1'000'000 ? 1 : 5;
+
+            DynamicBVH tree;
+            std::vector<int32_t> proxies(count);
+            Run("CreateProxy, incremental", buildIterations, count,
+                [&]
+                {
+                    tree.Clear();
+                    for (uint32_t i = 0; i < count; i++)
+                        proxies[i] = tree.CreateProxy(bounds[i], i);
+                });
+            fmt::print("  {:<44} {:>12} height  {:>9.1f} area ratio\n", "", tree.GetHeight(), tree.GetAreaRatio());
+
+            Run("Rebuild", buildIterations, count, [&] { tree.Rebuild(); });
+            fmt::print("  {:<44} {:>12} height  {:>9.1f} area ratio\n", "", tree.GetHeight(), tree.GetAreaRatio());
+
+            RunMoveBenchmark(tree, proxies, bounds, 0.01f);
+            RunMoveBenchmark(tree, proxies, bounds, 0.1f);
+            RunMoveBenchmark(tree, proxies, bounds, 1.0f);
+
+            RunQueryBenchmarks(tree, count, random);
+        }
+    }
+} // namespace Titan::Benchmarks
@@ -0,0 +1,137 @@
+#include <cmath>
+#include <thread>
+#include <Titan/Core/JobSystem.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    static constexpr uint32_t s_JobCount = 4096;
+    static constexpr uint32_t s_ChainLength = 256;
+    static constexpr uint32_t s_ParallelForCount = 1 << 20;
+
+    static void RunSpawnBenchmarks()
+    {
+        Run("Execute + Wait, 1 empty job", 10000, 1,
+            []
+            {
+                JobCounter counter;
+                JobSystem::Execute([] {}, &counter);
+                JobSystem::Wait(counter);
+            });
+
+        // Pushed on the main thread's deque, the workers only get them by stealing
+        Run("Execute + Wait, empty jobs", 200, s_JobCount,
+            []
+            {
+                JobCounter counter;
+                for (uint32_t i = 0; i < s_JobCount; i++)
+                    JobSystem::Execute([] {}, &counter);
+                JobSystem::Wait(counter);
+            });
+
+        // Every job is spawned by a worker, which keeps them on its own deque
+        Run("Nested Execute, empty jobs", 200, s_JobCount,
+            []
+            {
+                JobCounter counter;
+                constexpr uint32_t spawners = 16;
+                for (uint32_t i = 0; i < spawners; i++)
+                {
+                    JobSystem::Execute(
+                        [&counter]
+                        {
+                            for (uint32_t j = 0; j < s_JobCount / spawners; j++)
+                                JobSystem::Execute([] {}, &counter);
+                        },
+                        &counter);
+                }
+                JobSystem::Wait(counter);
+            });
+
+        // Larger than the inline job storage, measures the heap fallback
+        Run("Execute + Wait, 128 byte captures", 200, s_JobCount,
+            []
+            {
+                JobCounter counter;
+                std::array<uint64_t, 16> payload = {};
+                for (uint32_t i = 0; i < s_JobCount; i++)
+                    JobSystem::Execute([payload] { DoNotOptimize(payload); }, &counter);
+                JobSystem::Wait(counter);
+            });
+
+        // Submitted from a thread without a queue, goes through the shared queue
+        Run("Execute from a foreign thread", 200, s_JobCount,
+            []
+            {
+                JobCounter counter;
+                std::thread producer(
+                    [&counter]
+                    {
+                        for (uint32_t i = 0; i < s_JobCount; i++)
+                            JobSystem::Execute([] {}, &counter);
+                    });
+                producer.join();
+                JobSystem::Wait(counter);
+            });
+    }
+
+    static void RunDependencyBenchmarks()
+    {
+        // Each job is parked on the previous one and released when it finishes
+        Run("Dependency chain", 200, s_ChainLength,
+            []
+            {
+                std::array<JobCounter, s_ChainLength> counters;
+                for (uint32_t i = 0; i < s_ChainLength; i++)
+                    JobSystem::Execute([] {}, &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+                JobSystem::Wait(counters.back());
+            });
+
+        Run("Fan out, jobs waiting on one job", 200, s_JobCount,
+            []
+            {
+                JobCounter first;
+                JobCounter rest;
+                JobSystem::Execute([] { std::this_thread::sleep_for(std::chrono::microseconds(50)); }, &first);
+                for (uint32_t i = 0; i < s_JobCount; i++)
+                    JobSystem::Execute([] {}, &rest, &first);
+                JobSystem::Wait(rest);
+            });
+    }
+
+    static void RunParallelForBenchmark(std::vector<float>& values)
+    {
+        Run(fmt::format("ParallelFor {} workers", JobSystem::GetWorkerCount()), 50, s_ParallelForCount,
+            [&values]
+            {
+                JobSystem::ParallelFor(s_ParallelForCount, 4096,
+                                       [&values](uint32_t begin, uint32_t end)
+                                       {
+                                           for (uint32_t i = begin; i < end; i++)
+                                               values[i] = std::sqrt(values[i] * 1.0001f + 1.0f);
+                                       });
+            });
+    }
+
+    void RunJobSystemBenchmarks()
+    {
+        fmt::print("JobSystem\n");
+
+        JobSystem::Init();
+        RunSpawnBenchmarks();
+        RunDependencyBenchmarks();
+        JobSystem::Shutdown();
+
+        // Scaling over the worker count, without Init everything runs on the main thread
+        std::vector<float> values(s_ParallelForCount, 1.0f);
+        RunParallelForBenchmark(values);
+        const uint32_t maxWorkers = (std::max)(std::thread::hardware_concurrency(), 2u) - 1;
+        for (uint32_t workers = 1; workers <= maxWorkers; workers *= 2)
+        {
+            JobSystem::Init(workers);
+            RunParallelForBenchmark(values);
+            JobSystem::Shutdown();
+        }
+        DoNotOptimize(values[0]);
+    }
+} // namespace Titan::Benchmarks
@@ -0,0 +1,82 @@
+#include <cmath>
+#include <Titan/Core/JobSystem.h>
+#include <Titan/Renderer/Mesh.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    // UV sphere as the unindexed triangle list imports produce. The poles have degenerate triangles, and the
+    // u = 1 seam does not weld exactly, like split vertices in a real model.
+    static void CreateSphere(uint32_t rings, uint32_t segments, std::vector<glm::vec3>& positions,
+                             std::vector<glm::vec2>& texCoords)
+    {
+        positions.clear();
+        texCoords.clear();
+        positions.reserve((size_t)rings * segments * 6);
+        texCoords.reserve((size_t)rings * segments * 6);
+
+        auto addVertex = [&](uint32_t ring, uint32_t segment)
+        {
+            const glm::vec2 uv((float)segment / segments, (float)ring / rings);
+            const float theta = uv.y * glm::pi<float>();
+            const float phi = uv.x * glm::two_pi<float>();
+            positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            texCoords.push_back(uv);
+        };
+
+        for (uint32_t ring = 0; ring < rings; ring++)
+        {
+            for (uint32_t segment = 0; segment < segments; segment++)
+            {
+                addVertex(ring, segment);
+                addVertex(ring + 1, segment);
+                addVertex(ring + 1, segment + 1);
+                addVertex(ring, segment);
+                addVertex(ring + 1, segment + 1);
+                addVertex(ring, segment + 1);
+            }
+        }
+    }
+
+    // Normal smoothing and tangent generation, the welds and the per group accumulation
+    static void RunWeldBenchmark(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+                                 uint32_t iterations)
+    {
+        std::vector<glm::vec3> meshPositions;
+        std::vector<glm::vec2> meshTexCoords;
+        Ref<Mesh> mesh;
+
+        RunWithSetup(
+            fmt::format("Normals + tangents, {} workers", JobSystem::GetWorkerCount()), iterations,
+            (uint32_t)positions.size(),
+            [&]
+            {
+                mesh = nullptr;
+                meshPositions = positions;
+                meshTexCoords = texCoords;
+            },
+            [&] { mesh = Mesh::CreateFromTriangles(std::move(meshPositions), std::move(meshTexCoords)); });
+        DoNotOptimize(mesh);
+    }
+
+    void RunMeshBenchmarks()
+    {
+        fmt::print("Mesh\n");
+
+        // dragon_highres.glb is stored in LFS, a generated mesh keeps the suite runnable without it
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texCoords;
+        for (auto [rings, segments] : {std::pair{250u, 200u}, std::pair{1000u, 500u}})
+        {
+            CreateSphere(rings, segments, positions, texCoords);
+            fmt::print(" {} triangles, {} vertices\n", positions.size() / 3, positions.size());
+            const uint32_t iterations = positions.size() > 1'000'000 ? 3 : 10;
+
+            // Without Init everything runs on the main thread
+            RunWeldBenchmark(positions, texCoords, iterations);
+            JobSystem::Init();
+            RunWeldBenchmark(positions, texCoords, iterations);
+            JobSystem::Shutdown();
+        }
+    }
+} // namespace Titan::Benchmarks
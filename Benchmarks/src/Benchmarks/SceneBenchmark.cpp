@@ -0,0 +1,80 @@
+#include <Titan/Core/JobSystem.h>
+#include <Titan/Renderer/RendererAPI.h>
+#include <Titan/Scene/Scene.h>
+#include <Titan/Scene/SceneSerializer.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    // Saves the scene and loads it back into a fresh scene, in the YAML or the binary runtime format
+    static void RunSerializerBenchmarks(const Ref<Scene>& scene, uint32_t entityCount, bool runtime,
+                                        uint32_t iterations)
+    {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / (runtime ? "TitanBenchmark.titanbin" : "TitanBenchmark.titan");
+        const std::string filepath = path.string();
+
+        Run(runtime ? "SerializeRuntime" : "Serialize", iterations, entityCount,
+            [&]
+            {
+                SceneSerializer serializer(scene);
+                if (runtime)
+                    serializer.SerializeRuntime(filepath);
+                else
+                    serializer.Serialize(filepath);
+            });
+        fmt::print("  {:<44} {:>12} bytes\n", "", std::filesystem::file_size(path));
+
+        Ref<Scene> loaded;
+        bool succeeded = true;
+        RunWithSetup(
+            runtime ? "DeserializeRuntime" : "Deserialize", iterations, entityCount,
+            [&] { loaded = CreateRef<Scene>(); },
+            [&]
+            {
+                SceneSerializer serializer(loaded);
+                succeeded &= runtime ? serializer.DeserializeRuntime(filepath) : serializer.Deserialize(filepath);
+            });
+        if (!succeeded)
+            fmt::print("  {} could not be loaded back\n", filepath);
+
+        std::filesystem::remove(path);
+    }
+
+    // What entering play mode costs. Without Init the per component type copy jobs run one after another.
+    static void RunCopyBenchmark(const Ref<Scene>& scene, uint32_t entityCount, uint32_t iterations)
+    {
+        Ref<Scene> copy;
+        RunWithSetup(
+            fmt::format("Scene::Copy, {} workers", JobSystem::GetWorkerCount()), iterations, entityCount,
+            [&] { copy = nullptr; }, [&] { copy = Scene::Copy(scene); });
+    }
+
+    void RunSceneBenchmarks()
+    {
+        fmt::print("Scene\n");
+
+        // No graphics context, loads keep the render components without their GPU assets like headless runs.
+        // The serializers log every save and load, which would drown the results.
+        RendererAPI::SetAPI(RendererAPI::API::None);
+        const auto logLevel = Log::GetCoreLogger()->level();
+        Log::GetCoreLogger()->set_level(spdlog::level::warn);
+
+        for (uint32_t count : {10'000u, 100'000u})
+        {
+            fmt::print(" {} entities\n", count);
+
+            Ref<Scene> scene = CreateHierarchyScene(count);
+            const uint32_t iterations = count >= 100'000 ? 2 : 5;
+            RunSerializerBenchmarks(scene, count, false, iterations);
+            RunSerializerBenchmarks(scene, count, true, iterations);
+
+            RunCopyBenchmark(scene, count, iterations * 2);
+            JobSystem::Init();
+            RunCopyBenchmark(scene, count, iterations * 2);
+            JobSystem::Shutdown();
+        }
+
+        Log::GetCoreLogger()->set_level(logLevel);
+    }
+} // namespace Titan::Benchmarks
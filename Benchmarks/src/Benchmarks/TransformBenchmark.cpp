@@ -0,0 +1,45 @@
+#include <Titan/Scene/Components.h>
+#include <Titan/Scene/Scene.h>
+#include "Benchmark.h"
+
+namespace Titan::Benchmarks
+{
+    static constexpr uint32_t s_EntityCount = 100'000;
+    static constexpr uint32_t s_UpdateIterations = 50;
+
+    // Moves every n-th entity back and forth through its TransformComponent, then times the update alone.
+    // Children of a moved parent are recomputed too, so more entities than the share get new matrices.
+    static void RunMoveBenchmark(Scene& scene, float share)
+    {
+        const uint32_t stride = (uint32_t)(1.0f / share);
+        auto transforms = scene.GetAllEntitiesWith<TransformComponent>();
+        std::vector<entt::entity> entities(transforms.begin(), transforms.end());
+        float direction = 1.0f;
+
+        RunWithSetup(
+            fmt::format("UpdateWorldTransforms, {:.0f}% moving", share * 100.0f), s_UpdateIterations,
+            (uint32_t)entities.size(),
+            [&]
+            {
+                for (size_t i = 0; i < entities.size(); i += stride)
+                    transforms.get<TransformComponent>(entities[i]).Translation.x += direction;
+                direction = -direction;
+            },
+            [&] { scene.UpdateWorldTransforms(); });
+    }
+
+    void RunTransformBenchmarks()
+    {
+        fmt::print("World transforms\n");
+
+        Ref<Scene> scene = CreateHierarchyScene(s_EntityCount);
+        fmt::print(" {} entities\n", s_EntityCount);
+
+        // The first update builds the hierarchy order and the spatial index, the runs below only see changes
+        scene->UpdateWorldTransforms();
+        Run("UpdateWorldTransforms, no changes", s_UpdateIterations, s_EntityCount,
+            [&] { scene->UpdateWorldTransforms(); });
+        RunMoveBenchmark(*scene, 0.1f);
+        RunMoveBenchmark(*scene, 1.0f);
+    }
+} // namespace Titan::Benchmarks
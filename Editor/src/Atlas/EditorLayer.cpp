@@ -6,6 +6,7 @@
 #include <Titan/Renderer/RenderCommand.h>
 #include <Titan/Renderer/Renderer2D.h>
 #include <Titan/Renderer/SceneRenderer.h>
+#include <Titan/Renderer/SpriteAtlas.h>
 #include <Titan/Scene/Assets.h>
 #include <Titan/Scene/Components.h>
 #include <Titan/Scene/SceneSerializer.h>
@@ -18,6 +19,9 @@ namespace Titan
 {
     extern const std::filesystem::path g_AssetPath;
 
+    // Main thread time per frame spent on turning a background loaded scene into assets and entities
+    static constexpr float s_SceneLoadBudgetMillis = 4.0f;
+
     EditorLayer::EditorLayer() : Layer("EditorLayer") {}
 
     void EditorLayer::OnAttach()
@@ -32,9 +36,18 @@ namespace Titan
         m_EditorCamera = EditorCamera(30.0f, 1.778f, 0.1f, 1000.0f);
         m_EditorCamera.MouseRotate(glm::vec2(-0.5f, 0.5f)); // Rotate
 
-        m_StartIcon = Assets::Load<Texture2D>("resources/icons/play.svg");
-        m_StopIcon = Assets::Load<Texture2D>("resources/icons/stop.svg");
-        m_SimulateIcon = Assets::Load<Texture2D>("resources/icons/simulate.svg");
+        // All editor icons live in one atlas, rasterized for the current DPI
+        m_IconAtlas = CreateRef<IconAtlas>(Application::GetInstance()->GetWindow().GetContentScale());
+        m_IconAtlas->Add("resources/icons/play.svg", 32);
+        m_IconAtlas->Add("resources/icons/stop.svg", 32);
+        m_IconAtlas->Add("resources/icons/simulate.svg", 32);
+        ContentBrowserPanel::AddIcons(*m_IconAtlas);
+        m_IconAtlas->Build();
+
+        m_StartIcon = m_IconAtlas->Get("resources/icons/play.svg", 32);
+        m_StopIcon = m_IconAtlas->Get("resources/icons/stop.svg", 32);
+        m_SimulateIcon = m_IconAtlas->Get("resources/icons/simulate.svg", 32);
+        m_ContentBrowserPanel.SetIconAtlas(m_IconAtlas);
     }
 
     void EditorLayer::OnDetach() {}
@@ -44,8 +57,12 @@ namespace Titan
         if (ts.GetSeconds() > 0.0f)
             m_FPS = 1.0f / ts.GetSeconds();
 
+        if (m_SceneLoader)
+            UpdateSceneLoading();
+
         Renderer2D::ResetStats();
         GeometryRenderer::ResetStats();
+        ScriptEngine::ResetStats();
         switch (m_SceneState)
         {
             case SceneState::Edit:
@@ -88,6 +105,9 @@ namespace Titan
 
         RenderStatisticsPanel();
         RenderViewport();
+
+        if (m_SceneLoader)
+            RenderSceneLoadingProgress();
     }
 
     void EditorLayer::OnEvent(Event& event)
@@ -206,6 +226,31 @@ namespace Titan
         ImGui::Text("Meshes Rendered: %d", stats3d.GetTotalMeshCount());
         ImGui::Text("Vertices Rendered: %s",
                     FormatNumber(stats2d.GetTotalVertexCount() + stats3d.GetTotalVertexCount()).c_str());
+        ImGui::Text("Sprite Atlas Pages: %d", SpriteAtlas::GetPageCount());
+
+        if (m_SceneState == SceneState::Play)
+        {
+            ImGui::Separator();
+            for (const auto& system : m_ActiveScene->GetSystems())
+                ImGui::Text("%s: %.3fms", system->GetName().c_str(), system->GetLastMillis());
+
+            ImGui::Separator();
+            for (const auto& timing : ScriptEngine::GetClassTimings())
+                ImGui::Text("%s: %.3fms (%.3f - %.3fms)", timing.Name.c_str(), timing.AvgFrameMillis,
+                            timing.MinFrameMillis, timing.MaxFrameMillis);
+
+#ifdef TI_ENABLE_SCRIPT_PROFILING
+            // Stats are reset at the start of every frame, so these cover the last one
+            const auto scriptStats = ScriptEngine::GetStats();
+            ImGui::Separator();
+            ImGui::Text("Managed Allocations: %u (%s bytes)", scriptStats.Total.Allocations,
+                        FormatNumber(scriptStats.Total.AllocatedBytes).c_str());
+            ImGui::Text("Garbage Collections: %u (%.3fms)", scriptStats.Total.GCCount, scriptStats.Total.GCMillis);
+            for (const auto& [name, classStats] : scriptStats.Classes)
+                ImGui::Text("  %s: %u (%s bytes)", name.c_str(), classStats.Allocations,
+                            FormatNumber(classStats.AllocatedBytes).c_str());
+#endif
+        }
 
         ImGui::End();
     }
@@ -256,8 +301,9 @@ namespace Titan
             ImGui::SetCursorPosX(offsetX);
 
             // ----------------- STOP BUTTON -----------------
-            if (ImGui::ImageButton("ScenePlayButton", m_StopIcon->GetNativeTexture(), ImVec2(buttonSize, buttonSize),
-                                   ImVec2(0, 0), ImVec2(1, 1)))
+            if (ImGui::ImageButton("ScenePlayButton", m_IconAtlas->GetNativeTexture(), ImVec2(buttonSize, buttonSize),
+                                   ImVec2(m_StopIcon.UV0.x, m_StopIcon.UV0.y),
+                                   ImVec2(m_StopIcon.UV1.x, m_StopIcon.UV1.y)))
                 OnSceneStop();
         }
         else
@@ -269,8 +315,9 @@ namespace Titan
 
             // ----------------- PLAY BUTTON -----------------
             {
-                if (ImGui::ImageButton("ScenePlayButton", m_StartIcon->GetNativeTexture(),
-                                       ImVec2(buttonSize, buttonSize), ImVec2(0, 0), ImVec2(1, 1)))
+                if (ImGui::ImageButton("ScenePlayButton", m_IconAtlas->GetNativeTexture(),
+                                       ImVec2(buttonSize, buttonSize), ImVec2(m_StartIcon.UV0.x, m_StartIcon.UV0.y),
+                                       ImVec2(m_StartIcon.UV1.x, m_StartIcon.UV1.y)))
                 {
                     OnScenePlay();
                 }
@@ -280,8 +327,10 @@ namespace Titan
 
             // ----------------- SIMULATE BUTTON -----------------
             {
-                if (ImGui::ImageButton("SceneSimulateButton", m_SimulateIcon->GetNativeTexture(),
-                                       ImVec2(buttonSize, buttonSize), ImVec2(0, 0), ImVec2(1, 1)))
+                if (ImGui::ImageButton("SceneSimulateButton", m_IconAtlas->GetNativeTexture(),
+                                       ImVec2(buttonSize, buttonSize),
+                                       ImVec2(m_SimulateIcon.UV0.x, m_SimulateIcon.UV0.y),
+                                       ImVec2(m_SimulateIcon.UV1.x, m_SimulateIcon.UV1.y)))
                 {
                     OnSceneSimulate();
                 }
@@ -402,7 +451,7 @@ namespace Titan
         if (selected && selected.HasComponent<TransformComponent>() && m_GizmoType != -1)
         {
             auto& tc = selected.GetComponent<TransformComponent>();
-            glm::mat4 transform = tc.GetTransform();
+            glm::mat4 transform = m_ActiveScene->GetWorldTransform(selected);
 
             ImGuizmo::Manipulate(glm::value_ptr(view), glm::value_ptr(proj),
                                  static_cast<ImGuizmo::OPERATION>(m_GizmoType), ImGuizmo::LOCAL,
@@ -410,6 +459,13 @@ namespace Titan
 
             if (ImGuizmo::IsUsing())
             {
+                // The gizmo works in world space, bring the result back into the parent's space
+                UUID parent = selected.GetComponent<RelationshipComponent>().Parent;
+                if (parent)
+                    transform =
+                        glm::inverse(m_ActiveScene->GetWorldTransform(m_ActiveScene->GetEntityByUUID(parent))) *
+                        transform;
+
                 glm::vec3 t, r, s;
                 Math::DecomposeTransform(transform, t, r, s);
 
@@ -532,7 +588,7 @@ namespace Titan
         if (m_SceneState != SceneState::Edit)
             OnSceneStop();
 
-        if (path.extension().string() != ".titan")
+        if (path.extension().string() != ".titan" && !SceneSerializer::IsRuntimeScene(path))
         {
             TI_WARN("Could not load {0} - not a scene file", path.filename().string());
             return;
@@ -541,15 +597,42 @@ namespace Titan
         if (m_SceneState == SceneState::Play)
             OnSceneStop();
 
+        // The current scene stays open and editable until the new one is complete
+        m_SceneLoader = CreateScope<SceneLoader>(path);
+    }
+
+    void EditorLayer::UpdateSceneLoading()
+    {
+        if (!m_SceneLoader->Update(s_SceneLoadBudgetMillis))
+            return;
+
+        Scope<SceneLoader> loader = std::move(m_SceneLoader);
+        if (loader->HasFailed())
+        {
+            TI_WARN("Could not load {0}", loader->GetPath().filename().string());
+            return;
+        }
+
+        if (m_SceneState != SceneState::Edit)
+            OnSceneStop();
+
         Assets::Unload(m_EditorScenePath);
+        Assets::Add(loader->GetPath(), loader->GetScene());
 
-        Ref<Scene> newScene = Assets::Load<Scene>(path);
-        m_EditorScene = newScene;
+        m_EditorScene = loader->GetScene();
         m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
         m_SceneHierarchyPanel.SetContext(m_EditorScene);
 
         m_ActiveScene = m_EditorScene;
-        m_EditorScenePath = path;
+        m_EditorScenePath = loader->GetPath();
+    }
+
+    void EditorLayer::RenderSceneLoadingProgress()
+    {
+        ImGui::Begin("Loading Scene", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Text("%s", m_SceneLoader->GetPath().filename().string().c_str());
+        ImGui::ProgressBar(m_SceneLoader->GetProgress(), ImVec2(300.0f, 0.0f));
+        ImGui::End();
     }
 
     void EditorLayer::SaveScene()
@@ -562,7 +645,7 @@ namespace Titan
 
     void EditorLayer::OpenScene()
     {
-        std::string filepath = FileDialogs::OpenFile("Titan Scene (*.titan)\0*.titan\0");
+        std::string filepath = FileDialogs::OpenFile("Titan Scene (*.titan;*.titanbin)\0*.titan;*.titanbin\0");
         if (!filepath.empty())
         {
             OpenScene(filepath);
@@ -571,7 +654,8 @@ namespace Titan
 
     void EditorLayer::SaveSceneAs()
     {
-        std::string filepath = FileDialogs::SaveFile("Titan Scene (*.titan)\0*.titan\0");
+        std::string filepath =
+            FileDialogs::SaveFile("Titan Scene (*.titan)\0*.titan\0Titan Runtime Scene (*.titanbin)\0*.titanbin\0");
         if (!filepath.empty())
         {
             SerializeScene(m_ActiveScene, filepath);
@@ -582,7 +666,10 @@ namespace Titan
     void EditorLayer::SerializeScene(Ref<Scene> scene, const std::filesystem::path& path)
     {
         SceneSerializer serializer(scene);
-        serializer.Serialize(path.string());
+        if (SceneSerializer::IsRuntimeScene(path))
+            serializer.SerializeRuntime(path.string());
+        else
+            serializer.Serialize(path.string());
     }
 
     void EditorLayer::OnScenePlay()
@@ -593,6 +680,7 @@ namespace Titan
         m_SceneState = SceneState::Play;
 
         m_ActiveScene = Scene::Copy(m_EditorScene);
+        m_ActiveScene->BorrowPhysicsWorld(m_EditorScene);
         m_ActiveScene->OnRuntimeStart();
 
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
@@ -606,6 +694,7 @@ namespace Titan
         m_SceneState = SceneState::Simulate;
 
         m_ActiveScene = Scene::Copy(m_EditorScene);
+        m_ActiveScene->BorrowPhysicsWorld(m_EditorScene);
         m_ActiveScene->OnSimulationStart();
 
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
@@ -5,9 +5,11 @@
 #include <Titan/Events/KeyEvent.h>
 #include <Titan/Events/MouseEvent.h>
 #include <Titan/Renderer/Framebuffer.h>
+#include <Titan/Renderer/IconAtlas.h>
 #include <Titan/Renderer/Mesh.h>
 #include <Titan/Renderer/Texture.h>
 #include <Titan/Scene/Scene.h>
+#include <Titan/Scene/SceneLoader.h>
 #include "Panels/ContentBrowserPanel.h"
 #include "Panels/SceneHierarchyPanel.h"
 
@@ -32,6 +34,8 @@ namespace Titan
         void NewScene();
         void OpenScene();
         void OpenScene(const std::filesystem::path& path);
+        void UpdateSceneLoading();
+        void RenderSceneLoadingProgress();
         void SaveScene();
         void SaveSceneAs();
 
@@ -79,9 +83,10 @@ namespace Titan
         ImVec2 m_ViewportImageSize;
 
         // Resources
-        Ref<Texture2D> m_StartIcon;
-        Ref<Texture2D> m_SimulateIcon;
-        Ref<Texture2D> m_StopIcon;
+        Ref<IconAtlas> m_IconAtlas;
+        IconAtlas::Icon m_StartIcon;
+        IconAtlas::Icon m_SimulateIcon;
+        IconAtlas::Icon m_StopIcon;
 
         Ref<Mesh> m_DragonMesh;
 
@@ -89,6 +94,7 @@ namespace Titan
         Ref<Scene> m_ActiveScene;
         Ref<Scene> m_EditorScene;
         std::filesystem::path m_EditorScenePath;
+        Scope<SceneLoader> m_SceneLoader; // Set while a scene opens in the background
         Entity m_HoveredEntity;
         EditorCamera m_EditorCamera;
 
@@ -3,14 +3,29 @@ namespace Titan
 {
     extern const std::filesystem::path g_AssetPath = "assets";
 
-    ContentBrowserPanel::ContentBrowserPanel() : m_CurrentDirectory(g_AssetPath), m_Selected("")
+    static constexpr uint32_t s_ThumbnailIconSize = 128;
+
+    ContentBrowserPanel::ContentBrowserPanel() : m_CurrentDirectory(g_AssetPath), m_Selected("") {}
+
+    void ContentBrowserPanel::AddIcons(IconAtlas& atlas)
+    {
+        atlas.Add("resources/icons/folder.svg", s_ThumbnailIconSize);
+        atlas.Add("resources/icons/folder-opened.svg", s_ThumbnailIconSize);
+        atlas.Add("resources/icons/file.svg", s_ThumbnailIconSize);
+        atlas.Add("resources/icons/file-code.svg", s_ThumbnailIconSize);
+        atlas.Add("resources/icons/file-media.svg", s_ThumbnailIconSize);
+        atlas.Add("resources/icons/file-material.svg", s_ThumbnailIconSize);
+    }
+
+    void ContentBrowserPanel::SetIconAtlas(const Ref<IconAtlas>& atlas)
     {
-        m_DirectoryIcon = Assets::Load<Texture2D>("resources/icons/folder.svg");
-        m_DirectoryOpenIcon = Assets::Load<Texture2D>("resources/icons/folder-opened.svg");
-        m_FileTextIcon = Assets::Load<Texture2D>("resources/icons/file.svg");
-        m_FileCodeIcon = Assets::Load<Texture2D>("resources/icons/file-code.svg");
-        m_FileImageIcon = Assets::Load<Texture2D>("resources/icons/file-media.svg");
-        m_FileMaterialIcon = Assets::Load<Texture2D>("resources/icons/file-material.svg");
+        m_IconAtlas = atlas;
+        m_DirectoryIcon = atlas->Get("resources/icons/folder.svg", s_ThumbnailIconSize);
+        m_DirectoryOpenIcon = atlas->Get("resources/icons/folder-opened.svg", s_ThumbnailIconSize);
+        m_FileTextIcon = atlas->Get("resources/icons/file.svg", s_ThumbnailIconSize);
+        m_FileCodeIcon = atlas->Get("resources/icons/file-code.svg", s_ThumbnailIconSize);
+        m_FileImageIcon = atlas->Get("resources/icons/file-media.svg", s_ThumbnailIconSize);
+        m_FileMaterialIcon = atlas->Get("resources/icons/file-material.svg", s_ThumbnailIconSize);
     }
 
     void ContentBrowserPanel::OnImGuiRender()
@@ -60,7 +75,7 @@ namespace Titan
             }
 
             static float padding = 28.0f;
-            static float thumbnailSize = 128.0f;
+            static float thumbnailSize = (float)s_ThumbnailIconSize;
             float cellSize = thumbnailSize + padding;
 
             float panelWidth = ImGui::GetContentRegionAvail().x;
@@ -80,14 +95,15 @@ namespace Titan
                 auto relativePath = std::filesystem::relative(path, g_AssetPath);
                 std::string filenameString = relativePath.filename().string();
 
-                Ref<Texture2D> icon = GetIconForFile(path);
+                const IconAtlas::Icon& icon = GetIconForFile(path);
 
                 ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
                 ImGui::BeginGroup();
 
                 // --- Image ---
-                if (ImGui::ImageButton(filenameString.c_str(), icon->GetNativeTexture(), {thumbnailSize, thumbnailSize},
-                                       {0, 1}, {1, 0}))
+                if (ImGui::ImageButton(filenameString.c_str(), m_IconAtlas->GetNativeTexture(),
+                                       {thumbnailSize, thumbnailSize}, {icon.UV0.x, icon.UV0.y},
+                                       {icon.UV1.x, icon.UV1.y}))
                 {
                     m_Selected = path;
                     m_SelectedType = GetTypeForFile(path);
@@ -168,7 +184,7 @@ namespace Titan
         ImGui::End();
     }
 
-    Ref<Texture2D> ContentBrowserPanel::GetIconForFile(const std::filesystem::path& filePath)
+    const IconAtlas::Icon& ContentBrowserPanel::GetIconForFile(const std::filesystem::path& filePath)
     {
         if (std::filesystem::is_directory(filePath))
         {
@@ -214,7 +230,7 @@ namespace Titan
             ext == ".hlsl")
             return AssetType::Shader;
 
-        if (ext == ".titan")
+        if (ext == ".titan" || ext == ".titanbin")
             return AssetType::Scene;
 
         return AssetType::None;
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Titan/PCH.h"
-#include "Titan/Renderer/Texture.h"
+#include "Titan/Renderer/IconAtlas.h"
 #include "Titan/Scene/Assets.h"
 
 namespace Titan
@@ -14,10 +14,14 @@ namespace Titan
 
         void OnImGuiRender();
 
+        // Registers the icons this panel draws, must be called before the atlas is built
+        static void AddIcons(IconAtlas& atlas);
+        void SetIconAtlas(const Ref<IconAtlas>& atlas);
+
     private:
         void RenderBrowser();
         void RenderProperties();
-        Ref<Texture2D> GetIconForFile(const std::filesystem::path& filePath);
+        const IconAtlas::Icon& GetIconForFile(const std::filesystem::path& filePath);
         AssetType GetTypeForFile(const std::filesystem::path& filePath);
 
     private:
@@ -29,12 +33,13 @@ namespace Titan
         std::string m_LastSelectedStr;
 
         // Icons
-        Ref<Texture2D> m_DirectoryIcon;
-        Ref<Texture2D> m_DirectoryOpenIcon;
-        Ref<Texture2D> m_FileTextIcon;
-        Ref<Texture2D> m_FileCodeIcon;
-        Ref<Texture2D> m_FileImageIcon;
-        Ref<Texture2D> m_FileMaterialIcon;
+        Ref<IconAtlas> m_IconAtlas;
+        IconAtlas::Icon m_DirectoryIcon;
+        IconAtlas::Icon m_DirectoryOpenIcon;
+        IconAtlas::Icon m_FileTextIcon;
+        IconAtlas::Icon m_FileCodeIcon;
+        IconAtlas::Icon m_FileImageIcon;
+        IconAtlas::Icon m_FileMaterialIcon;
     };
 
 } // namespace Titan
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "SceneHierarchyPanel.h"
 #include "../Components.h"
 #include "Titan/Renderer/Renderer2D.h"
+#include "Titan/Renderer/SpriteAtlas.h"
 #include "Titan/Scene/Components.h"
 #include "Titan/Scripting/ScriptEngine.h"
 
@@ -38,13 +39,31 @@ namespace Titan
     {
         ImGui::Begin("Scene Hierarchy");
 
-        auto view = m_Context->m_Registry.view<entt::entity>();
+        // Children are drawn under their parent
+        auto view = m_Context->m_Registry.view<RelationshipComponent>();
         for (auto entity : view)
         {
+            // An entity whose parent is missing is drawn as a root so it can still be selected
+            UUID parent = view.get<RelationshipComponent>(entity).Parent;
+            if (parent && m_Context->m_EntityMap.contains(parent))
+                continue;
+
             Entity e{entity, m_Context.get()};
             DrawEntityNode(e);
         }
 
+        if (m_HasPendingParent)
+        {
+            if (m_PendingParent)
+                m_Context->ParentEntity(m_PendingChild, m_PendingParent);
+            else
+                m_Context->UnparentEntity(m_PendingChild);
+
+            m_PendingChild = {};
+            m_PendingParent = {};
+            m_HasPendingParent = false;
+        }
+
         if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
             m_SelectionContext = {};
 
@@ -61,6 +80,12 @@ namespace Titan
                 {
                     m_Context->DuplicateEntity(m_SelectionContext);
                 }
+                if (m_SelectionContext.GetComponent<RelationshipComponent>().Parent && ImGui::MenuItem("Unparent"))
+                {
+                    m_PendingChild = m_SelectionContext;
+                    m_PendingParent = {};
+                    m_HasPendingParent = true;
+                }
             }
             else
             {
@@ -161,16 +186,46 @@ namespace Titan
     {
         auto& tag = entity.GetComponent<TagComponent>().Tag;
 
+        auto& relationship = entity.GetComponent<RelationshipComponent>();
+
         ImGuiTreeNodeFlags flags =
             ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
+        if (relationship.Children.empty())
+            flags |= ImGuiTreeNodeFlags_Leaf;
         bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
         if (ImGui::IsItemClicked())
         {
             m_SelectionContext = entity;
         }
 
+        if (ImGui::BeginDragDropSource())
+        {
+            UUID uuid = entity.GetUUID();
+            ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &uuid, sizeof(UUID));
+            ImGui::TextUnformatted(tag.c_str());
+            ImGui::EndDragDropSource();
+        }
+
+        if (ImGui::BeginDragDropTarget())
+        {
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+            {
+                UUID uuid = *(const UUID*)payload->Data;
+                m_PendingChild = m_Context->GetEntityByUUID(uuid);
+                m_PendingParent = entity;
+                m_HasPendingParent = true;
+            }
+            ImGui::EndDragDropTarget();
+        }
+
         if (opened)
         {
+            for (UUID child : relationship.Children)
+            {
+                if (Entity childEntity = m_Context->GetEntityByUUID(child))
+                    DrawEntityNode(childEntity);
+            }
+
             ImGui::TreePop();
         }
     }
@@ -227,7 +282,15 @@ namespace Titan
         // --- Texture preview / button ---
         if (texture)
         {
-            ImGui::ImageButton(label, texture->GetNativeTexture(), previewSize, ImVec2(0, 1), ImVec2(1, 0));
+            // Atlased sprites only cover their rect of the page
+            ImVec2 uv0(0, 1), uv1(1, 0);
+            SpriteAtlas::Region region;
+            if (SpriteAtlas::FindRegion(texture, region) && region.Texture == texture)
+            {
+                uv0 = ImVec2(region.UVMin.x, region.UVMax.y);
+                uv1 = ImVec2(region.UVMax.x, region.UVMin.y);
+            }
+            ImGui::ImageButton(label, texture->GetNativeTexture(), previewSize, uv0, uv1);
         }
         else
         {
@@ -274,7 +337,7 @@ namespace Titan
             strcpy_s(buffer, sizeof(buffer), tag.c_str());
             if (ImGui::InputText("Name", buffer, sizeof(buffer)))
             {
-                tag = std::string(buffer);
+                entity.SetName(std::string(buffer));
             }
         }
 
@@ -366,7 +429,7 @@ namespace Titan
                                                });
         DrawComponent<MeshRendererComponent>(
             "Mesh Renderer", entity,
-            [](auto& component)
+            [entity](auto& component) mutable
             {
                 float buttonWidth = ImGui::GetContentRegionAvail().x;
                 ImGui::Button(
@@ -378,7 +441,8 @@ namespace Titan
                     {
                         const wchar_t* path = (const wchar_t*)payload->Data;
                         std::filesystem::path meshPath = std::filesystem::path(g_AssetPath) / path;
-                        component.MeshRef = Assets::Load<Mesh>(meshPath.string());
+                        Ref<Mesh> mesh = Assets::Load<Mesh>(meshPath.string());
+                        entity.PatchComponent<MeshRendererComponent>([&](auto& mrc) { mrc.MeshRef = mesh; });
                     }
                     ImGui::EndDragDropTarget();
                 }
@@ -407,8 +471,10 @@ namespace Titan
             });
         DrawComponent<DirectionalLightComponent>("Directional Light", entity, [](auto& component)
                                                  { Component::DirectionControl("Direction", component.Direction); });
+        // Edits in place rebuild the entity's body in the physics world the scene keeps between play sessions
+        bool physicsEdited = false;
         DrawComponent<Rigidbody2DComponent>("Rigidbody 2D", entity,
-                                            [](auto& component)
+                                            [&physicsEdited](auto& component)
                                             {
                                                 const char* bodyTypeStrings[] = {"Static", "Dynamic", "Kinematic"};
                                                 const char* currentBodyTypeString =
@@ -422,6 +488,7 @@ namespace Titan
                                                         {
                                                             currentBodyTypeString = bodyTypeStrings[i];
                                                             component.Type = (Rigidbody2DComponent::BodyType)i;
+                                                            physicsEdited = true;
                                                         }
 
                                                         if (isSelected)
@@ -431,15 +498,16 @@ namespace Titan
                                                     ImGui::EndCombo();
                                                 }
 
-                                                ImGui::Checkbox("Fixed Rotation", &component.FixedRotation);
+                                                physicsEdited |=
+                                                    ImGui::Checkbox("Fixed Rotation", &component.FixedRotation);
                                             });
 
         DrawComponent<BoxCollider2DComponent>(
             "Box Collider 2D", entity,
-            [](auto& component)
+            [&physicsEdited](auto& component)
             {
-                ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset));
-                ImGui::DragFloat2("Size", glm::value_ptr(component.Size));
+                physicsEdited |= ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset));
+                physicsEdited |= ImGui::DragFloat2("Size", glm::value_ptr(component.Size));
                 float buttonWidth = ImGui::GetContentRegionAvail().x;
                 ImGui::Button(std::format("Material: {}", component.Material->SourcePath).c_str(),
                               ImVec2(buttonWidth, 0.0f));
@@ -450,6 +518,7 @@ namespace Titan
                         const wchar_t* path = (const wchar_t*)payload->Data;
                         std::filesystem::path materialPath = std::filesystem::path(g_AssetPath) / path;
                         component.Material = Assets::Load<Physics2DMaterial>(materialPath.string());
+                        physicsEdited = true;
                     }
                     ImGui::EndDragDropTarget();
                 }
@@ -457,10 +526,10 @@ namespace Titan
 
         DrawComponent<CircleCollider2DComponent>(
             "Circle Collider 2D", entity,
-            [](auto& component)
+            [&physicsEdited](auto& component)
             {
-                ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset));
-                ImGui::DragFloat("Radius", &component.Radius);
+                physicsEdited |= ImGui::DragFloat2("Offset", glm::value_ptr(component.Offset));
+                physicsEdited |= ImGui::DragFloat("Radius", &component.Radius);
                 float buttonWidth = ImGui::GetContentRegionAvail().x;
                 ImGui::Button(std::format("Material: {}", component.Material->SourcePath).c_str(),
                               ImVec2(buttonWidth, 0.0f));
@@ -471,11 +540,15 @@ namespace Titan
                         const wchar_t* path = (const wchar_t*)payload->Data;
                         std::filesystem::path materialPath = std::filesystem::path(g_AssetPath) / path;
                         component.Material = Assets::Load<Physics2DMaterial>(materialPath.string());
+                        physicsEdited = true;
                     }
                     ImGui::EndDragDropTarget();
                 }
             });
 
+        if (physicsEdited)
+            m_Context->MarkPhysicsDirty(entity);
+
         DrawComponent<ScriptComponent>(
             "Script", entity,
             [entity, scene = m_Context](auto& component) mutable
@@ -495,7 +568,7 @@ namespace Titan
                 bool sceneRunning = scene->IsRunning();
                 if (sceneRunning)
                 {
-                    Ref<ScriptInstance> scriptInstance = ScriptEngine::GetEntityScriptInstance(entity.GetUUID());
+                    ScriptInstance* scriptInstance = ScriptEngine::GetEntityScriptInstance(entity.GetUUID());
                     if (scriptInstance)
                     {
                         const auto& fields = scriptInstance->GetScriptClass()->GetFields();
@@ -28,6 +28,11 @@ namespace Titan
     private:
         Ref<Scene> m_Context;
         Entity m_SelectionContext;
+
+        // Reparenting is deferred until the tree has been drawn, it changes the registry being iterated
+        Entity m_PendingChild;
+        Entity m_PendingParent;
+        bool m_HasPendingParent = false;
     };
 
 } // namespace Titan
\ No newline at end of file
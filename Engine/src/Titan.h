@@ -29,6 +29,7 @@
 #include "Titan/Scene/Entity.h"
 #include "Titan/Scene/Scene.h"
 #include "Titan/Scene/SceneCamera.h"
+#include "Titan/Scene/SceneLoader.h"
 #include "Titan/Scene/SceneSerializer.h"
 #include "Titan/Scene/ScriptableEntity.h"
 // Utils
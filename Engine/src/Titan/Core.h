@@ -13,8 +13,17 @@
     #else
         #define TI_API
     #endif
+    #define TI_DEBUGBREAK() __debugbreak()
+#elif defined(TI_PLATFORM_LINUX)
+    // Linux is headless only (Server), see Platform/Linux
+    #ifdef TI_DYNAMIC_LINK
+        #define TI_API __attribute__((visibility("default")))
+    #else
+        #define TI_API
+    #endif
+    #define TI_DEBUGBREAK() __builtin_trap()
 #else
-    #error Titan Engine only supports Windows for now!
+    #error Titan Engine only supports Windows and headless Linux for now!
 #endif
 
 #ifdef TI_BUILD_DEBUG
@@ -24,6 +33,9 @@
     #ifndef TI_ENABLE_LOGGING
         #define TI_ENABLE_LOGGING
     #endif
+    #ifndef TI_ENABLE_SCRIPT_PROFILING
+        #define TI_ENABLE_SCRIPT_PROFILING
+    #endif
 #endif
 
 #ifdef TI_ENABLE_ASSERTS
@@ -32,7 +44,7 @@
         if (!(x))                                            \
         {                                                    \
             TI_ERROR("Assertion Failed: " __VA_ARGS__); \
-            __debugbreak();                                  \
+            TI_DEBUGBREAK();                                 \
         }                                                    \
     }
 #define TI_CORE_ASSERT(x, ...)                                    \
@@ -40,7 +52,7 @@
         if (!(x))                                                 \
         {                                                         \
             TI_CORE_ERROR("Assertion Failed: " __VA_ARGS__); \
-            __debugbreak();                                       \
+            TI_DEBUGBREAK();                                      \
         }                                                         \
     }
 #else
@@ -57,7 +69,7 @@
 #endif
 
 #define BIT(x) (1 << x)
-#define TI_BIND_EVENT_FN(fn) std::bind(&##fn, this, std::placeholders::_1)
+#define TI_BIND_EVENT_FN(fn) std::bind(&fn, this, std::placeholders::_1)
 
 #define TI_CONCAT_INNER(a, b) a##b
 #define TI_CONCAT(a, b) TI_CONCAT_INNER(a, b)
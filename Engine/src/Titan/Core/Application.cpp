@@ -1,5 +1,6 @@
 #include "Titan/Core/Application.h"
 #include "Titan/Core/Input.h"
+#include "Titan/Core/JobSystem.h"
 #include "Titan/Core/KeyCodes.h"
 #include "Titan/Core/Log.h"
 #include "Titan/PCH.h"
@@ -17,20 +18,33 @@ namespace Titan
 
     Application* Application::s_Instance = nullptr;
 
-    Application::Application(const std::string& name)
+    Application::Application(const std::string& name, bool headless) : m_Headless(headless)
     {
         TI_PROFILE_BEGIN_SESSION("Startup", "profile-startup");
         TI_CORE_ASSERT(!s_Instance, "Application already exists! There can only be one");
         s_Instance = this;
 
-        m_Window = Scope<Window>(Window::Create(WindowProps(name)));
-        m_Window->SetEventCallback(TI_BIND_EVENT_FN(Application::OnEvent));
+        if (m_Headless)
+        {
+            // No context will ever exist, asset loading checks this to skip GPU resources
+            RendererAPI::SetAPI(RendererAPI::API::None);
+        }
+        else
+        {
+            m_Window = Scope<Window>(Window::Create(WindowProps(name)));
+            m_Window->SetEventCallback(TI_BIND_EVENT_FN(Application::OnEvent));
+        }
 
-        Renderer::Init();
+        JobSystem::Init();
+        if (!m_Headless)
+            Renderer::Init();
         ScriptEngine::Init();
 
-        m_ImGuiLayer = new ImGuiLayer();
-        PushOverlay(m_ImGuiLayer);
+        if (!m_Headless)
+        {
+            m_ImGuiLayer = new ImGuiLayer();
+            PushOverlay(m_ImGuiLayer);
+        }
         TI_PROFILE_END_SESSION();
     }
 
@@ -39,6 +53,7 @@ namespace Titan
         TI_PROFILE_FUNCTION();
 
         ScriptEngine::Shutdown();
+        JobSystem::Shutdown();
     }
 
     void Application::Close()
@@ -55,7 +70,8 @@ namespace Titan
         {
             TI_PROFILE_SCOPE("Application::Run Gameloop");
 
-            float time = (float)glfwGetTime(); // TODO: Platform Indepentend Time Query (Time::GetCurrent()???)
+            // TODO: Platform Indepentend Time Query (Time::GetCurrent()???)
+            float time = m_Headless ? m_Clock.Elapsed() : (float)glfwGetTime();
             Timestep timestep = time - m_LastFrameTime;
             m_LastFrameTime = time;
 
@@ -68,6 +84,9 @@ namespace Titan
                     layer->OnUpdate(timestep);
             }
 
+            if (m_Headless)
+                continue;
+
             m_ImGuiLayer->Begin();
             for (Layer* layer : m_LayerStack)
             {
@@ -2,6 +2,7 @@
 
 #include "Titan/Core.h"
 #include "Titan/Core/LayerStack.h"
+#include "Titan/Core/Timer.h"
 #include "Titan/Core/Timestep.h"
 #include "Titan/Core/Window.h"
 #include "Titan/Events/Event.h"
@@ -16,7 +17,8 @@ namespace Titan
     public:
         /// @brief Creates the Application (which manages window, etc)
         /// @param name The Window Title
-        Application(const std::string& name = "Titan App");
+        /// @param headless Runs without window, renderer and ImGui (servers, CI), layers still get OnUpdate
+        Application(const std::string& name = "Titan App", bool headless = false);
         /// @brief Destructs the Application
         virtual ~Application();
 
@@ -39,6 +41,9 @@ namespace Titan
         /// @return the window of this instance
         inline Window& GetWindow() { return *m_Window; }
 
+        /// @brief Whether the application runs without window and renderer
+        inline bool IsHeadless() const { return m_Headless; }
+
         /// @brief Submits a function that should be executed in the main thread
         /// @param function the function
         void SubmitToMainThread(const std::function<void()>& function);
@@ -56,10 +61,12 @@ namespace Titan
     private:
         static Application* s_Instance;
         Scope<Window> m_Window;
+        bool m_Headless = false;
+        Timer m_Clock;
         bool m_Running = true;
         bool m_Minimized = false;
         LayerStack m_LayerStack;
-        ImGuiLayer* m_ImGuiLayer;
+        ImGuiLayer* m_ImGuiLayer = nullptr;
         float m_LastFrameTime = 0.0f;
         std::vector<std::function<void()>> m_MainThreadQueue;
         std::mutex m_MainThreadQueueMutex;
@@ -4,7 +4,7 @@
 #include "Titan/Core/Log.h"
 #include "Titan/PCH.h"
 
-#ifdef TI_PLATFORM_WINDOWS
+#if defined(TI_PLATFORM_WINDOWS) || defined(TI_PLATFORM_LINUX)
 
 extern Titan::Application* Titan::CreateApplication();
 
@@ -0,0 +1,449 @@
+#include "JobSystem.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+    struct Job
+    {
+        // First member, the header only sees the storage pointer
+        alignas(std::max_align_t) std::byte Storage[JobSystem::JobStorageSize];
+        void (*Thunk)(void* callable) = nullptr;
+        JobCounter* Counter = nullptr;
+        const JobCounter* Dependency = nullptr;
+        Job* NextParked = nullptr;
+    };
+    static_assert(offsetof(Job, Storage) == 0);
+
+    // Chase-Lev deque over a fixed ring. Only the owning thread calls Push and Pop (bottom end),
+    // any thread may Steal (top end).
+    class WorkStealingQueue
+    {
+    public:
+        static constexpr int64_t Capacity = 4096;
+
+        bool Push(Job* job)
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            const int64_t top = m_Top.load(std::memory_order_acquire);
+            if (bottom - top >= Capacity)
+                return false;
+
+            m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        Job* Pop()
+        {
+            const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last job, race the thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                    job = nullptr;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return nullptr;
+
+            Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+
+    private:
+        alignas(64) std::atomic<int64_t> m_Top = 0;
+        alignas(64) std::atomic<int64_t> m_Bottom = 0;
+        std::array<std::atomic<Job*>, Capacity> m_Jobs = {};
+    };
+
+    struct JobSystemData
+    {
+        // Index 0 belongs to the main thread, worker i owns queue i + 1
+        std::vector<std::unique_ptr<WorkStealingQueue>> Queues;
+        std::vector<std::thread> Workers;
+
+        // Jobs from threads without a queue
+        std::deque<Job*> SharedQueue;
+        std::mutex SharedQueueMutex;
+        std::atomic<uint32_t> SharedJobCount = 0;
+
+        // Jobs whose dependency is not done yet, listed per counter through Job::NextParked
+        std::unordered_map<const JobCounter*, Job*> ParkedJobs;
+        std::mutex ParkedMutex;
+        std::atomic<uint32_t> ParkedCount = 0;
+
+        // Free jobs, threads take and return them in batches of s_JobBatch
+        std::vector<std::unique_ptr<Job[]>> JobBlocks;
+        std::vector<Job*> FreeJobs;
+        std::mutex FreeJobsMutex;
+
+        std::atomic<bool> Running = false;
+        std::atomic<uint32_t> PendingJobs = 0;
+        std::atomic<uint32_t> SleepingWorkers = 0;
+        std::mutex WakeMutex;
+        std::condition_variable WakeCondition;
+    };
+
+    static JobSystemData s_Data;
+
+    static constexpr int32_t s_NoQueue = -1;
+    static thread_local int32_t t_QueueIndex = s_NoQueue;
+    static thread_local uint32_t t_StealSeed = 0;
+
+    static constexpr size_t s_JobBatch = 64;
+
+    // Jobs cached by a thread, so Execute and RunJob only lock the pool once per batch
+    struct JobCache
+    {
+        std::vector<Job*> FreeJobs;
+
+        ~JobCache()
+        {
+            std::scoped_lock<std::mutex> lock(s_Data.FreeJobsMutex);
+            s_Data.FreeJobs.insert(s_Data.FreeJobs.end(), FreeJobs.begin(), FreeJobs.end());
+        }
+    };
+
+    static thread_local JobCache t_JobCache;
+
+    static Job* AcquireJob()
+    {
+        std::vector<Job*>& cache = t_JobCache.FreeJobs;
+        if (cache.empty())
+        {
+            std::scoped_lock<std::mutex> lock(s_Data.FreeJobsMutex);
+            if (s_Data.FreeJobs.size() < s_JobBatch)
+            {
+                Job* block = s_Data.JobBlocks.emplace_back(std::make_unique<Job[]>(s_JobBatch)).get();
+                for (size_t i = 0; i < s_JobBatch; i++)
+                    s_Data.FreeJobs.push_back(block + i);
+            }
+            cache.assign(s_Data.FreeJobs.end() - s_JobBatch, s_Data.FreeJobs.end());
+            s_Data.FreeJobs.resize(s_Data.FreeJobs.size() - s_JobBatch);
+        }
+
+        Job* job = cache.back();
+        cache.pop_back();
+        return job;
+    }
+
+    static void ReleaseJob(Job* job)
+    {
+        std::vector<Job*>& cache = t_JobCache.FreeJobs;
+        cache.push_back(job);
+
+        // Producer threads drain the pool while workers fill their cache, hand the surplus back
+        if (cache.size() >= 2 * s_JobBatch)
+        {
+            std::scoped_lock<std::mutex> lock(s_Data.FreeJobsMutex);
+            s_Data.FreeJobs.insert(s_Data.FreeJobs.end(), cache.end() - s_JobBatch, cache.end());
+            cache.resize(cache.size() - s_JobBatch);
+        }
+    }
+
+    static void WakeWorkers(bool all)
+    {
+        // Pairs with the SleepingWorkers increment in WorkerLoop, one of the two sides always sees the other
+        if (s_Data.SleepingWorkers.load() == 0 && !all)
+            return;
+
+        {
+            std::scoped_lock<std::mutex> lock(s_Data.WakeMutex);
+        }
+        if (all)
+            s_Data.WakeCondition.notify_all();
+        else
+            s_Data.WakeCondition.notify_one();
+    }
+
+    static void PushShared(Job* job)
+    {
+        std::scoped_lock<std::mutex> lock(s_Data.SharedQueueMutex);
+        s_Data.SharedQueue.push_back(job);
+        s_Data.SharedJobCount.fetch_add(1, std::memory_order_release);
+    }
+
+    static void Submit(Job* job)
+    {
+        s_Data.PendingJobs.fetch_add(1);
+
+        if (t_QueueIndex == s_NoQueue || !s_Data.Queues[t_QueueIndex]->Push(job))
+            PushShared(job);
+
+        WakeWorkers(false);
+    }
+
+    static void Park(Job* job)
+    {
+        {
+            // Pairs with the ParkedCount check in FinishJob: either the finishing thread sees the parked job,
+            // or the dependency already reads done here
+            std::scoped_lock<std::mutex> lock(s_Data.ParkedMutex);
+            s_Data.ParkedCount.fetch_add(1);
+            if (job->Dependency->Value.load() != 0)
+            {
+                Job*& head = s_Data.ParkedJobs[job->Dependency];
+                job->NextParked = head;
+                head = job;
+                return;
+            }
+            s_Data.ParkedCount.fetch_sub(1);
+        }
+        Submit(job);
+    }
+
+    static void ReleaseParkedJobs(const JobCounter* counter)
+    {
+        std::scoped_lock<std::mutex> lock(s_Data.ParkedMutex);
+        auto it = s_Data.ParkedJobs.find(counter);
+        if (it == s_Data.ParkedJobs.end())
+            return;
+
+        // The counter may have been freed and its address reused, only release jobs that see it done.
+        // Parked jobs keep their dependency alive, so reading it is safe.
+        Job** link = &it->second;
+        while (Job* job = *link)
+        {
+            if (!job->Dependency->IsDone())
+            {
+                link = &job->NextParked;
+                continue;
+            }
+
+            *link = job->NextParked;
+            s_Data.ParkedCount.fetch_sub(1);
+            Submit(job);
+        }
+
+        if (!it->second)
+            s_Data.ParkedJobs.erase(it);
+    }
+
+    static void FinishJob(JobCounter* counter)
+    {
+        // The owner may free the counter as soon as it reads done, past the decrement it is only a lookup key
+        if (counter && counter->Value.fetch_sub(1) == 1 && s_Data.ParkedCount.load() > 0)
+            ReleaseParkedJobs(counter);
+    }
+
+    static Job* FindJob()
+    {
+        Job* job = nullptr;
+
+        if (t_QueueIndex != s_NoQueue)
+            job = s_Data.Queues[t_QueueIndex]->Pop();
+
+        if (!job && s_Data.SharedJobCount.load(std::memory_order_acquire) > 0)
+        {
+            std::scoped_lock<std::mutex> lock(s_Data.SharedQueueMutex);
+            if (!s_Data.SharedQueue.empty())
+            {
+                job = s_Data.SharedQueue.front();
+                s_Data.SharedQueue.pop_front();
+                s_Data.SharedJobCount.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!job)
+        {
+            // Start at a different victim each time so thieves spread out
+            t_StealSeed = t_StealSeed * 1664525u + 1013904223u;
+            const uint32_t queueCount = (uint32_t)s_Data.Queues.size();
+            for (uint32_t i = 0; i < queueCount && !job; i++)
+            {
+                const uint32_t victim = (t_StealSeed + i) % queueCount;
+                if ((int32_t)victim != t_QueueIndex)
+                    job = s_Data.Queues[victim]->Steal();
+            }
+        }
+
+        if (job)
+            s_Data.PendingJobs.fetch_sub(1);
+        return job;
+    }
+
+    static void RunJob(Job* job)
+    {
+        job->Thunk(job->Storage);
+
+        JobCounter* counter = job->Counter;
+        ReleaseJob(job);
+        FinishJob(counter);
+    }
+
+    static void WorkerLoop(uint32_t queueIndex)
+    {
+        const std::string name = fmt::format("Job Worker {}", queueIndex);
+        TI_PROFILE_THREAD(name.c_str());
+
+        t_QueueIndex = (int32_t)queueIndex;
+        t_StealSeed = queueIndex;
+
+        while (true)
+        {
+            if (Job* job = FindJob())
+            {
+                RunJob(job);
+                continue;
+            }
+
+            if (!s_Data.Running.load())
+                break;
+
+            s_Data.SleepingWorkers.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(s_Data.WakeMutex);
+                s_Data.WakeCondition.wait(lock, []
+                                          { return s_Data.PendingJobs.load() > 0 || !s_Data.Running.load(); });
+            }
+            s_Data.SleepingWorkers.fetch_sub(1);
+        }
+
+        t_QueueIndex = s_NoQueue;
+    }
+
+    void JobSystem::Init(uint32_t workerCount)
+    {
+        TI_PROFILE_FUNCTION();
+        TI_CORE_ASSERT(!s_Data.Running, "JobSystem is already initialized!");
+
+        // At least one worker, fire and forget jobs must make progress even if nobody waits on them
+        if (workerCount == 0)
+            workerCount = (std::max)(std::thread::hardware_concurrency(), 2u) - 1;
+
+        s_Data.Running = true;
+        s_Data.Queues.clear();
+        for (uint32_t i = 0; i < workerCount + 1; i++)
+            s_Data.Queues.push_back(std::make_unique<WorkStealingQueue>());
+
+        t_QueueIndex = 0;
+        for (uint32_t i = 1; i <= workerCount; i++)
+            s_Data.Workers.emplace_back(WorkerLoop, i);
+
+        TI_CORE_INFO("JobSystem started {} workers", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        TI_PROFILE_FUNCTION();
+        if (!s_Data.Running)
+            return;
+
+        // Workers only leave once every queue is empty
+        s_Data.Running = false;
+        WakeWorkers(true);
+        for (auto& worker : s_Data.Workers)
+            worker.join();
+        s_Data.Workers.clear();
+
+        while (Job* job = FindJob())
+            RunJob(job);
+        TI_CORE_ASSERT(s_Data.ParkedJobs.empty(), "Jobs are still waiting on a dependency that never finished!");
+
+        t_QueueIndex = s_NoQueue;
+        s_Data.Queues.clear();
+    }
+
+    void* JobSystem::AllocateJob()
+    {
+        return AcquireJob()->Storage;
+    }
+
+    void JobSystem::SubmitJob(void* storage, JobThunk thunk, JobCounter* counter, const JobCounter* dependency)
+    {
+        Job* job = reinterpret_cast<Job*>(storage);
+        job->Thunk = thunk;
+        job->Counter = counter;
+        job->Dependency = dependency;
+
+        if (counter)
+            counter->Value.fetch_add(1, std::memory_order_relaxed);
+
+        if (s_Data.Queues.empty())
+        {
+            // Not initialized (tools, early startup), run on the calling thread
+            TI_CORE_ASSERT(!dependency || dependency->IsDone(), "Job dependency can never finish without workers!");
+            RunJob(job);
+            return;
+        }
+
+        if (dependency && !dependency->IsDone())
+            Park(job);
+        else
+            Submit(job);
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function)
+    {
+        TI_PROFILE_FUNCTION();
+        if (count == 0)
+            return;
+
+        batchSize = (std::max)(batchSize, 1u);
+        if (s_Data.Queues.empty() || count <= batchSize)
+        {
+            function(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+        {
+            const uint32_t end = (std::min)(begin + batchSize, count);
+            Execute([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+
+        // The caller takes the first batch instead of going idle
+        function(0, batchSize);
+        Wait(counter);
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        TI_PROFILE_FUNCTION();
+        while (!counter.IsDone())
+        {
+            if (Job* job = FindJob())
+                RunJob(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return (uint32_t)s_Data.Workers.size();
+    }
+
+    bool JobSystem::IsMainThread()
+    {
+        return t_QueueIndex == 0;
+    }
+
+} // namespace Titan
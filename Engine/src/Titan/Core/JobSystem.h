@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    /// @brief Counts the outstanding jobs of a group, the group is done once it is back at zero
+    struct JobCounter
+    {
+        std::atomic<uint32_t> Value = 0;
+
+        bool IsDone() const { return Value.load(std::memory_order_acquire) == 0; }
+    };
+
+    /// @brief Work stealing thread pool sized to the hardware.
+    /// Every worker owns a lock free deque, it pushes and pops its own jobs at the bottom while idle workers
+    /// steal from the top. Threads that are not workers (asset loaders, the script thread) submit through a shared
+    /// queue. The main thread owns a deque as well and runs jobs while it waits, so it is never just blocked.
+    class TI_API JobSystem
+    {
+    public:
+        /// @brief fn(begin, end) for one batch of a parallel for
+        using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+        /// @brief Bytes of captures a job stores inline. Jobs are pooled, so only larger callables allocate.
+        static constexpr size_t JobStorageSize = 48;
+
+        /// @brief Starts the workers, must be called from the main thread
+        /// @param workerCount number of worker threads, 0 uses one per hardware thread besides the main thread
+        static void Init(uint32_t workerCount = 0);
+        /// @brief Finishes all submitted jobs and joins the workers
+        static void Shutdown();
+
+        /// @brief Submits a job
+        /// @param function the callable to run, moved into the job
+        /// @param counter incremented now and decremented once the job ran, may be null
+        /// @param dependency the job does not start before this counter is done, may be null. It is parked on the
+        /// counter meanwhile and must not outlive it.
+        template <typename Function>
+        static void Execute(Function&& function, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr)
+        {
+            using Callable = std::decay_t<Function>;
+            void* storage = AllocateJob();
+            if constexpr (sizeof(Callable) <= JobStorageSize && alignof(Callable) <= alignof(std::max_align_t))
+            {
+                new (storage) Callable(std::forward<Function>(function));
+                SubmitJob(
+                    storage,
+                    [](void* callable)
+                    {
+                        (*static_cast<Callable*>(callable))();
+                        static_cast<Callable*>(callable)->~Callable();
+                    },
+                    counter, dependency);
+            }
+            else
+            {
+                new (storage) Callable*(new Callable(std::forward<Function>(function)));
+                SubmitJob(
+                    storage,
+                    [](void* callable)
+                    {
+                        Callable* heapCallable = *static_cast<Callable**>(callable);
+                        (*heapCallable)();
+                        delete heapCallable;
+                    },
+                    counter, dependency);
+            }
+        }
+
+        /// @brief Runs function over [0, count) in batches of batchSize and returns once every batch ran
+        static void ParallelFor(uint32_t count, uint32_t batchSize, const RangeFunction& function);
+
+        /// @brief Runs other jobs until the counter is done
+        static void Wait(const JobCounter& counter);
+
+        /// @brief Number of worker threads, not counting the main thread
+        static uint32_t GetWorkerCount();
+        /// @brief True on the thread that called Init
+        static bool IsMainThread();
+
+    private:
+        /// @brief Runs the callable in a job's storage and destroys it
+        using JobThunk = void (*)(void* callable);
+
+        /// @brief Storage of a job from the pool, the callable is constructed in it before SubmitJob
+        static void* AllocateJob();
+        static void SubmitJob(void* storage, JobThunk thunk, JobCounter* counter, const JobCounter* dependency);
+    };
+
+} // namespace Titan
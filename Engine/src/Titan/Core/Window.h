@@ -38,6 +38,9 @@ namespace Titan
         virtual bool IsVSync() const = 0;
         virtual void Maximize() = 0;
 
+        // Ratio between the current DPI and the platform default DPI
+        virtual float GetContentScale() const = 0;
+
         virtual void* GetNativeWindow() const = 0;
 
         static Window* Create(const WindowProps& props = WindowProps());
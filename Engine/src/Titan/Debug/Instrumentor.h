@@ -8,10 +8,12 @@
     #define TI_PROFILE_END_SESSION() OPTICK_STOP_CAPTURE(); OPTICK_SAVE_CAPTURE(ti_profile_path)
     #define TI_PROFILE_SCOPE(name) OPTICK_EVENT(name)
     #define TI_PROFILE_FUNCTION() OPTICK_EVENT()
+    #define TI_PROFILE_THREAD(name) OPTICK_THREAD(name)
 #else
     #define TI_PROFILE_BEGIN_SESSION(name, filepath)
     #define TI_PROFILE_END_SESSION()
     #define TI_PROFILE_SCOPE(name)
     #define TI_PROFILE_FUNCTION()
+    #define TI_PROFILE_THREAD(name)
 #endif
 // clang-format on
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Titan/PCH.h"
+#include "Titan/Utils/FileSystem.h"
+
+#ifdef TI_PLATFORM_LINUX
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Titan
+{
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        TI_PROFILE_FUNCTION();
+
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            close(file);
+            return;
+        }
+
+        // The mapping keeps its own reference to the file, the descriptor is not needed afterwards
+        void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (view == MAP_FAILED)
+            return;
+
+        madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = (uint64_t)info.st_size;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_Data(other.m_Data),
+          m_Size(other.m_Size),
+          m_FileHandle(other.m_FileHandle),
+          m_MappingHandle(other.m_MappingHandle)
+    {
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+        other.m_FileHandle = nullptr;
+        other.m_MappingHandle = nullptr;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            std::swap(m_Data, other.m_Data);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_FileHandle, other.m_FileHandle);
+            std::swap(m_MappingHandle, other.m_MappingHandle);
+        }
+        return *this;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap((void*)m_Data, (size_t)m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_FileHandle = nullptr;
+        m_MappingHandle = nullptr;
+    }
+
+} // namespace Titan
+
+#endif
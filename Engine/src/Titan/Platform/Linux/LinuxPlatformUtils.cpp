@@ -0,0 +1,27 @@
+#include "Titan/PCH.h"
+#include "Titan/Utils/PlatformUtils.h"
+
+#ifdef TI_PLATFORM_LINUX
+
+namespace Titan
+{
+
+    // Linux builds are headless, there is nothing to show a dialog on
+    std::string FileDialogs::OpenFile(const char* filter)
+    {
+        return std::string();
+    }
+
+    std::string FileDialogs::SaveFile(const char* filter)
+    {
+        return std::string();
+    }
+
+    bool Debug::isRenderdocAttached()
+    {
+        return false;
+    }
+
+} // namespace Titan
+
+#endif
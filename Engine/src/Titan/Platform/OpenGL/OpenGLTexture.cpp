@@ -1,9 +1,6 @@
 #include "OpenGLTexture.h"
 #include "Titan/PCH.h"
 #include "Titan/Utils/PlatformUtils.h"
-#include "nanosvg.h"
-#include "nanosvgrast.h"
-#include "stb_image.h"
 // clang-format off
 #ifdef APIENTRY
     #undef APIENTRY
@@ -14,119 +11,80 @@
 namespace Titan
 {
 
-    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, TextureSettings settings) : m_Path(path)
+    static GLenum TextureWrapToGL(TextureWrap wrap)
     {
-        TI_PROFILE_FUNCTION();
-
-        int width = 0, height = 0, channels = 4;
-        unsigned char* data = nullptr;
-
-        // Check file extension
-        auto ext = path.substr(path.find_last_of(".") + 1);
-        for (auto& c : ext)
-            c = std::tolower(c);
-        if (ext == "svg")
+        switch (wrap)
         {
-            width = height = 256;
-            data = new unsigned char[width * height * 4]; // RGBA
-
-            NSVGimage* image = nsvgParseFromFile(path.c_str(), "px", 96);
-            TI_CORE_ASSERT(image, "Failed to load SVG!");
-
-            NSVGrasterizer* rast = nsvgCreateRasterizer();
+            case TextureWrap::Repeat:
+                return GL_REPEAT;
+            case TextureWrap::MirroredRepeat:
+                return GL_MIRRORED_REPEAT;
+            case TextureWrap::ClampToEdge:
+                return GL_CLAMP_TO_EDGE;
+            case TextureWrap::ClampToBorder:
+                return GL_CLAMP_TO_BORDER;
+            default:
+                return GL_REPEAT;
+        }
+    }
 
-            float scale = float(width) / image->width;
-            nsvgRasterize(rast, image, 0, 0, scale, data, width, height, width * 4);
+    static GLenum TextureFilteringToGL(TextureFiltering filter)
+    {
+        switch (filter)
+        {
+            case TextureFiltering::Nearest:
+                return GL_NEAREST;
+            case TextureFiltering::MipmapNearest:
+                return GL_NEAREST_MIPMAP_NEAREST;
+            case TextureFiltering::Linear:
+                return GL_LINEAR;
+            case TextureFiltering::MipmapLinear:
+                return GL_LINEAR_MIPMAP_LINEAR;
+            default:
+                return GL_LINEAR;
+        }
+    }
 
-            // --- Flip vertically ---
-            for (int y = 0; y < height / 2; y++)
-            {
-                int opposite = height - y - 1;
-                for (int x = 0; x < width * 4; x++)
-                    std::swap(data[y * width * 4 + x], data[opposite * width * 4 + x]);
-            }
+    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, TextureSettings settings)
+        : OpenGLTexture2D(TextureImage::Decode(path), settings)
+    {
+    }
 
-            nsvgDeleteRasterizer(rast);
-            nsvgDelete(image);
+    OpenGLTexture2D::OpenGLTexture2D(const TextureImage& image, TextureSettings settings)
+        : m_Path(image.Path), m_Settings(settings)
+    {
+        TI_PROFILE_FUNCTION();
 
+        if (image.Channels == 4)
+        {
             m_InternalFormat = GL_RGBA8;
             m_DataFormat = GL_RGBA;
         }
-
-        else
+        else if (image.Channels == 3)
+        {
+            m_InternalFormat = GL_RGB8;
+            m_DataFormat = GL_RGB;
+        }
+        else if (image.Channels == 2)
         {
-            stbi_set_flip_vertically_on_load(1);
-            data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-            TI_CORE_ASSERT(data, "Failed to load image!");
-
-            if (channels == 4)
-            {
-                m_InternalFormat = GL_RGBA8;
-                m_DataFormat = GL_RGBA;
-            }
-            else if (channels == 3)
-            {
-                m_InternalFormat = GL_RGB8;
-                m_DataFormat = GL_RGB;
-            }
-            else if (channels == 2)
-            {
-                m_InternalFormat = GL_RG8;
-                m_DataFormat = GL_RG;
-            }
-            else if (channels == 1)
-            {
-                m_InternalFormat = GL_R8;
-                m_DataFormat = GL_RED;
-            }
-
-            TI_CORE_ASSERT(m_InternalFormat & m_DataFormat, "Format not supported!");
+            m_InternalFormat = GL_RG8;
+            m_DataFormat = GL_RG;
         }
+        else if (image.Channels == 1)
+        {
+            m_InternalFormat = GL_R8;
+            m_DataFormat = GL_RED;
+        }
+
+        TI_CORE_ASSERT(m_InternalFormat & m_DataFormat, "Format not supported!");
 
-        m_Width = width;
-        m_Height = height;
+        m_Width = image.Width;
+        m_Height = image.Height;
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
         glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-        auto wrapToGL = [](TextureWrap wrap) -> GLenum
-        {
-            switch (wrap)
-            {
-                case TextureWrap::Repeat:
-                    return GL_REPEAT;
-                case TextureWrap::MirroredRepeat:
-                    return GL_MIRRORED_REPEAT;
-                case TextureWrap::ClampToEdge:
-                    return GL_CLAMP_TO_EDGE;
-                case TextureWrap::ClampToBorder:
-                    return GL_CLAMP_TO_BORDER;
-                default:
-                    return GL_REPEAT;
-            }
-        };
-
-        auto filterToGL = [](TextureFiltering filter) -> GLenum
-        {
-            switch (filter)
-            {
-                case TextureFiltering::Nearest:
-                    return GL_NEAREST;
-                case TextureFiltering::MipmapNearest:
-                    return GL_NEAREST_MIPMAP_NEAREST;
-                case TextureFiltering::Linear:
-                    return GL_LINEAR;
-                case TextureFiltering::MipmapLinear:
-                    return GL_LINEAR_MIPMAP_LINEAR;
-                default:
-                    return GL_LINEAR;
-            }
-        };
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, filterToGL(settings.MinFilter));
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, filterToGL(settings.MagFilter));
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, wrapToGL(settings.HorizontalWrap));
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, wrapToGL(settings.VerticalWrap));
+        ApplySettings();
 
         if (settings.MinFilter == TextureFiltering::MipmapNearest ||
             settings.MinFilter == TextureFiltering::MipmapLinear)
@@ -134,16 +92,25 @@ namespace Titan
             glGenerateTextureMipmap(m_RendererID);
         }
 
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+        glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE,
+                            image.Pixels.data());
+    }
 
-        if (ext == "svg")
-            delete[] data;
-        else
-            stbi_image_free(data);
+    static TextureSettings InternalTextureSettings()
+    {
+        TextureSettings settings;
+        settings.MinFilter = TextureFiltering::Linear;
+        settings.MagFilter = TextureFiltering::Linear;
+        return settings;
     }
 
     OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-        : m_Width(width), m_Height(height), m_Path("[internal]")
+        : OpenGLTexture2D(width, height, InternalTextureSettings())
+    {
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, TextureSettings settings)
+        : m_Path("[internal]"), m_Settings(settings), m_Width(width), m_Height(height)
     {
         TI_PROFILE_FUNCTION();
         m_InternalFormat = GL_RGBA8;
@@ -151,12 +118,15 @@ namespace Titan
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
         glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+        ApplySettings();
+    }
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    void OpenGLTexture2D::ApplySettings()
+    {
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, TextureFilteringToGL(m_Settings.MinFilter));
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, TextureFilteringToGL(m_Settings.MagFilter));
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, TextureWrapToGL(m_Settings.HorizontalWrap));
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, TextureWrapToGL(m_Settings.VerticalWrap));
     }
 
     OpenGLTexture2D::~OpenGLTexture2D()
@@ -174,6 +144,13 @@ namespace Titan
         glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
     }
 
+    void OpenGLTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        TI_PROFILE_FUNCTION();
+        TI_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is outside of the texture!");
+        glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+    }
+
     void OpenGLTexture2D::Bind(uint32_t slot) const
     {
         glBindTextureUnit(slot, m_RendererID);
@@ -15,15 +15,19 @@ namespace Titan
     {
     public:
         OpenGLTexture2D(const std::string& path, TextureSettings settings);
+        OpenGLTexture2D(const TextureImage& image, TextureSettings settings);
         OpenGLTexture2D(uint32_t width, uint32_t height);
+        OpenGLTexture2D(uint32_t width, uint32_t height, TextureSettings settings);
         virtual ~OpenGLTexture2D();
 
         virtual uint32_t GetWidth() const override { return m_Width; }
         virtual uint32_t GetHeight() const override { return m_Height; }
 
         virtual std::string GetPath() const override { return m_Path; }
+        virtual TextureSettings GetSettings() const override { return m_Settings; }
 
         virtual void SetData(void* data, uint32_t size) override;
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
         inline void* GetNativeTexture() const override
         {
@@ -39,14 +43,18 @@ namespace Titan
 
         virtual bool operator==(const Texture& other) const override
         {
-            return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
+            return GetNativeTexture() == other.GetNativeTexture();
         }
 
+    private:
+        void ApplySettings();
+
     private:
         std::string m_Path;
+        TextureSettings m_Settings;
         uint32_t m_Width, m_Height;
         uint32_t m_RendererID;
-        GLenum m_InternalFormat, m_DataFormat;
+        GLenum m_InternalFormat = 0, m_DataFormat = 0;
 
         uint64_t m_BindlessHandle = 0;
         bool m_HandleResident = false;
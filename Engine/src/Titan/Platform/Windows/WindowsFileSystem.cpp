@@ -0,0 +1,93 @@
+#include "Titan/PCH.h"
+#include "Titan/Utils/FileSystem.h"
+
+#ifdef TI_PLATFORM_WINDOWS
+
+namespace Titan
+{
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        TI_PROFILE_FUNCTION();
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return;
+        }
+
+        m_Data = static_cast<const uint8_t*>(view);
+        m_Size = (uint64_t)size.QuadPart;
+        m_FileHandle = file;
+        m_MappingHandle = mapping;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_Data(other.m_Data),
+          m_Size(other.m_Size),
+          m_FileHandle(other.m_FileHandle),
+          m_MappingHandle(other.m_MappingHandle)
+    {
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+        other.m_FileHandle = nullptr;
+        other.m_MappingHandle = nullptr;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            std::swap(m_Data, other.m_Data);
+            std::swap(m_Size, other.m_Size);
+            std::swap(m_FileHandle, other.m_FileHandle);
+            std::swap(m_MappingHandle, other.m_MappingHandle);
+        }
+        return *this;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle((HANDLE)m_MappingHandle);
+        if (m_FileHandle)
+            CloseHandle((HANDLE)m_FileHandle);
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_FileHandle = nullptr;
+        m_MappingHandle = nullptr;
+    }
+
+} // namespace Titan
+
+#endif
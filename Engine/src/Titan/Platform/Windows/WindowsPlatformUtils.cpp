@@ -2,6 +2,8 @@
 #include "Titan/PCH.h"
 #include "Titan/Utils/PlatformUtils.h"
 
+#ifdef TI_PLATFORM_WINDOWS
+
 // clang-format off
 #ifdef APIENTRY
     #undef APIENTRY
@@ -64,4 +66,6 @@ namespace Titan
         return GetModuleHandleA("renderdoc.dll") != NULL;
     }
 
-} // namespace Titan
\ No newline at end of file
+} // namespace Titan
+
+#endif
@@ -194,4 +194,11 @@ namespace Titan
         glfwMaximizeWindow(m_Window);
     }
 
+    float WindowsWindow::GetContentScale() const
+    {
+        float xScale = 1.0f, yScale = 1.0f;
+        glfwGetWindowContentScale(m_Window, &xScale, &yScale);
+        return xScale;
+    }
+
 } // namespace Titan
\ No newline at end of file
@@ -31,6 +31,7 @@ namespace Titan
         void SetVSync(bool enabled) override;
         bool IsVSync() const override;
         void Maximize() override;
+        float GetContentScale() const override;
         inline void* GetNativeWindow() const override { return m_Window; };
 
     private:
@@ -0,0 +1,244 @@
+#include "IconAtlas.h"
+#include "Titan/Core/Timer.h"
+#include "Titan/PCH.h"
+#include "Titan/Utils/FileSystem.h"
+#include "Titan/Utils/Hash.h"
+#include "nanosvg.h"
+#include "nanosvgrast.h"
+
+namespace Titan
+{
+    static const std::filesystem::path s_IconCacheDirectory = "cache/icons";
+
+    static constexpr uint32_t s_IconCacheVersion = 1;
+    static constexpr char s_IconCacheMagic[4] = {'T', 'I', 'C', 'N'};
+
+    // Transparent border around every icon so linear filtering never picks up a neighbour
+    static constexpr uint32_t s_IconPadding = 1;
+    static constexpr uint32_t s_MaxAtlasSize = 4096;
+
+    struct CachedIconHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint64_t Key;
+        uint32_t Width;
+        uint32_t Height;
+    };
+
+    static uint64_t ComputeIconKey(const MappedFile& svg, uint32_t pixelSize, float dpiScale)
+    {
+        uint64_t key = Hash::Combine(Hash::FNV1aOffsetBasis, s_IconCacheVersion);
+        key = Hash::Combine(key, pixelSize);
+        key = Hash::FNV1a(&dpiScale, sizeof(float), key);
+        return Hash::FNV1a(svg.GetData(), svg.GetSize(), key);
+    }
+
+    static std::filesystem::path GetCachedIconPath(const std::string& svgPath, uint32_t pixelSize)
+    {
+        std::string normalized = std::filesystem::path(svgPath).lexically_normal().generic_string();
+        std::string filename = fmt::format("{}.{}.{:016x}.rgba", std::filesystem::path(svgPath).stem().string(),
+                                           pixelSize, Hash::FNV1a(normalized));
+        return s_IconCacheDirectory / filename;
+    }
+
+    static bool ReadCachedIcon(const std::filesystem::path& path, uint64_t key, uint32_t pixelSize,
+                               std::vector<uint8_t>& pixels)
+    {
+        MappedFile file(path);
+        if (!file.IsValid() || file.GetSize() < sizeof(CachedIconHeader))
+            return false;
+
+        CachedIconHeader header;
+        memcpy(&header, file.GetData(), sizeof(CachedIconHeader));
+
+        const uint64_t pixelBytes = (uint64_t)pixelSize * pixelSize * 4;
+        if (memcmp(header.Magic, s_IconCacheMagic, sizeof(header.Magic)) != 0 ||
+            header.Version != s_IconCacheVersion || header.Key != key || header.Width != pixelSize ||
+            header.Height != pixelSize || file.GetSize() < sizeof(CachedIconHeader) + pixelBytes)
+            return false;
+
+        const uint8_t* data = file.GetData() + sizeof(CachedIconHeader);
+        pixels.assign(data, data + pixelBytes);
+        return true;
+    }
+
+    static void WriteCachedIcon(const std::filesystem::path& path, uint64_t key, uint32_t pixelSize,
+                                const std::vector<uint8_t>& pixels)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            CachedIconHeader header = {};
+            memcpy(header.Magic, s_IconCacheMagic, sizeof(header.Magic));
+            header.Version = s_IconCacheVersion;
+            header.Key = key;
+            header.Width = pixelSize;
+            header.Height = pixelSize;
+
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(CachedIconHeader));
+            out.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+            if (!out)
+            {
+                TI_CORE_WARN("Could not write cached icon {}", path.string());
+                return;
+            }
+        }
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+            std::filesystem::remove(tempPath, ec);
+    }
+
+    IconAtlas::IconAtlas(float dpiScale) : m_DpiScale(dpiScale) {}
+
+    void IconAtlas::Add(const std::string& svgPath, uint32_t size)
+    {
+        for (const auto& entry : m_Entries)
+        {
+            if (entry.Path == svgPath && entry.Size == size)
+                return;
+        }
+
+        Entry entry;
+        entry.Path = svgPath;
+        entry.Size = size;
+        entry.PixelSize = (uint32_t)std::ceil(size * m_DpiScale);
+        m_Entries.push_back(std::move(entry));
+    }
+
+    void IconAtlas::LoadPixels(Entry& entry)
+    {
+        TI_PROFILE_FUNCTION();
+
+        const uint32_t pixelSize = entry.PixelSize;
+        entry.Pixels.assign((size_t)pixelSize * pixelSize * 4, 0);
+
+        MappedFile svg(entry.Path);
+        if (!svg.IsValid())
+        {
+            TI_CORE_WARN("Could not open icon {}", entry.Path);
+            return;
+        }
+
+        uint64_t key = ComputeIconKey(svg, pixelSize, m_DpiScale);
+        std::filesystem::path cachedPath = GetCachedIconPath(entry.Path, pixelSize);
+        if (ReadCachedIcon(cachedPath, key, pixelSize, entry.Pixels))
+            return;
+
+        // nsvgParse modifies its input, so it gets a null terminated copy of the mapping
+        std::string source(reinterpret_cast<const char*>(svg.GetData()), svg.GetSize());
+        NSVGimage* image = nsvgParse(source.data(), "px", 96.0f * m_DpiScale);
+        if (!image || image->width <= 0.0f || image->height <= 0.0f)
+        {
+            TI_CORE_WARN("Failed to parse icon {}", entry.Path);
+            if (image)
+                nsvgDelete(image);
+            return;
+        }
+
+        // Fit the longer side and center the other, rows stay top down which is what ImGui UVs expect
+        float scale = pixelSize / (std::max)(image->width, image->height);
+        float offsetX = (pixelSize - image->width * scale) * 0.5f;
+        float offsetY = (pixelSize - image->height * scale) * 0.5f;
+
+        NSVGrasterizer* rast = nsvgCreateRasterizer();
+        nsvgRasterize(rast, image, offsetX, offsetY, scale, entry.Pixels.data(), pixelSize, pixelSize, pixelSize * 4);
+        nsvgDeleteRasterizer(rast);
+        nsvgDelete(image);
+
+        WriteCachedIcon(cachedPath, key, pixelSize, entry.Pixels);
+    }
+
+    bool IconAtlas::Pack(uint32_t atlasSize)
+    {
+        // Shelf packing, entries are sorted tallest first by Build
+        uint32_t x = 0, y = 0, shelfHeight = 0;
+        for (auto& entry : m_Entries)
+        {
+            const uint32_t paddedSize = entry.PixelSize + s_IconPadding * 2;
+            if (paddedSize > atlasSize)
+                return false;
+
+            if (x + paddedSize > atlasSize)
+            {
+                x = 0;
+                y += shelfHeight;
+                shelfHeight = 0;
+            }
+
+            if (y + paddedSize > atlasSize)
+                return false;
+
+            entry.X = x + s_IconPadding;
+            entry.Y = y + s_IconPadding;
+            x += paddedSize;
+            shelfHeight = (std::max)(shelfHeight, paddedSize);
+        }
+
+        return true;
+    }
+
+    void IconAtlas::Build()
+    {
+        TI_PROFILE_FUNCTION();
+
+        Timer timer;
+
+        for (auto& entry : m_Entries)
+            LoadPixels(entry);
+
+        std::sort(m_Entries.begin(), m_Entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.PixelSize > b.PixelSize; });
+
+        uint32_t atlasSize = 256;
+        while (!Pack(atlasSize))
+        {
+            atlasSize *= 2;
+            TI_CORE_ASSERT(atlasSize <= s_MaxAtlasSize, "Icons do not fit into a {0}x{0} atlas!", s_MaxAtlasSize);
+        }
+
+        std::vector<uint8_t> pixels((size_t)atlasSize * atlasSize * 4, 0);
+        const float texel = 1.0f / atlasSize;
+        for (auto& entry : m_Entries)
+        {
+            const size_t rowBytes = (size_t)entry.PixelSize * 4;
+            for (uint32_t row = 0; row < entry.PixelSize; row++)
+            {
+                memcpy(pixels.data() + ((size_t)(entry.Y + row) * atlasSize + entry.X) * 4,
+                       entry.Pixels.data() + row * rowBytes, rowBytes);
+            }
+
+            entry.UVs.UV0 = {entry.X * texel, entry.Y * texel};
+            entry.UVs.UV1 = {(entry.X + entry.PixelSize) * texel, (entry.Y + entry.PixelSize) * texel};
+
+            entry.Pixels.clear();
+            entry.Pixels.shrink_to_fit();
+        }
+
+        m_Texture = Texture2D::Create(atlasSize, atlasSize);
+        m_Texture->SetData(pixels.data(), (uint32_t)pixels.size());
+
+        TI_CORE_INFO("Built {}x{} icon atlas with {} icons in {:.2f}ms", atlasSize, atlasSize, m_Entries.size(),
+                     timer.ElapsedMillis());
+    }
+
+    const IconAtlas::Icon& IconAtlas::Get(const std::string& svgPath, uint32_t size) const
+    {
+        for (const auto& entry : m_Entries)
+        {
+            if (entry.Path == svgPath && entry.Size == size)
+                return entry.UVs;
+        }
+
+        TI_CORE_ASSERT(false, "Icon {} ({}px) was not added to the atlas!", svgPath, size);
+        static Icon s_Missing;
+        return s_Missing;
+    }
+
+} // namespace Titan
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Titan/PCH.h"
+#include "Titan/Renderer/Texture.h"
+
+namespace Titan
+{
+
+    // Packs rasterized SVG icons, at one or more sizes each, into a single texture.
+    // Rasterized icons are cached in cache/icons keyed by the SVG contents, pixel size and DPI scale,
+    // so only new or edited icons go through nanosvg on startup.
+    class TI_API IconAtlas
+    {
+    public:
+        struct Icon
+        {
+            // Top left and bottom right, in the orientation ImGui::Image expects
+            glm::vec2 UV0 = {0.0f, 0.0f};
+            glm::vec2 UV1 = {1.0f, 1.0f};
+        };
+
+    public:
+        IconAtlas(float dpiScale = 1.0f);
+
+        // Size is in logical pixels, the icon is rasterized at size * DPI scale
+        void Add(const std::string& svgPath, uint32_t size);
+        void Build();
+
+        const Icon& Get(const std::string& svgPath, uint32_t size) const;
+
+        const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+        void* GetNativeTexture() const { return m_Texture ? m_Texture->GetNativeTexture() : nullptr; }
+
+    private:
+        struct Entry
+        {
+            std::string Path;
+            uint32_t Size = 0;
+            uint32_t PixelSize = 0;
+            std::vector<uint8_t> Pixels; // RGBA, only kept until Build
+            uint32_t X = 0, Y = 0;
+            Icon UVs;
+        };
+
+        void LoadPixels(Entry& entry);
+        bool Pack(uint32_t atlasSize);
+
+    private:
+        float m_DpiScale;
+        std::vector<Entry> m_Entries;
+        Ref<Texture2D> m_Texture;
+    };
+
+} // namespace Titan
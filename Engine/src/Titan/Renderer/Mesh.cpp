@@ -1,10 +1,45 @@
 #include "Mesh.h"
+#include "MeshCache.h"
+#include "Titan/Core/JobSystem.h"
+#include "Titan/Core/Timer.h"
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 
+#include <bit>
+#include <numeric>
+
 namespace Titan
 {
+    // Part of the cooked mesh key, changing these invalidates every cooked mesh
+    static constexpr uint32_t s_ImportFlags = aiProcess_Triangulate | aiProcess_GenNormals |
+                                              aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
+                                              aiProcess_ImproveCacheLocality;
+
+    // Weld groups are a handful of vertices each, batch them so a job is worth scheduling
+    static constexpr uint32_t s_WeldGroupBatchSize = 1024;
+    // Vertices per sorted run, runs are then merged pairwise until one is left
+    static constexpr size_t s_WeldSortChunkSize = 16384;
+
+    // Remembers the files an import opens, the cooked mesh depends on all of them (glTF buffers, OBJ materials)
+    class RecordingIOSystem : public Assimp::DefaultIOSystem
+    {
+    public:
+        Assimp::IOStream* Open(const char* file, const char* mode = "rb") override
+        {
+            Assimp::IOStream* stream = DefaultIOSystem::Open(file, mode);
+            if (stream && std::find(m_Files.begin(), m_Files.end(), file) == m_Files.end())
+                m_Files.emplace_back(file);
+            return stream;
+        }
+
+        const std::vector<std::string>& GetFiles() const { return m_Files; }
+
+    private:
+        std::vector<std::string> m_Files;
+    };
+
     struct RawMeshData
     {
         std::vector<glm::vec3> Positions;
@@ -13,9 +48,35 @@ namespace Titan
         std::vector<glm::vec3> Tangents;
     };
 
-    static void ProcessMesh(aiMesh* mesh, RawMeshData& data, std::vector<uint8_t>& materialIndexOut,
-                            uint8_t materialIdx)
+    // One aiMesh and the slice of the output streams it fills
+    struct MeshImportJob
+    {
+        const aiMesh* Mesh = nullptr;
+        size_t VertexOffset = 0;
+        size_t VertexCount = 0;
+    };
+
+    static size_t CountTriangleVertices(const aiMesh* mesh)
     {
+        size_t count = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
+        {
+            if (mesh->mFaces[i].mNumIndices == 3)
+                count += 3;
+        }
+        return count;
+    }
+
+    // Tangents are generated afterwards in ComputeTangents, once normals are smoothed.
+    // Writes exactly job.VertexCount vertices starting at job.VertexOffset, so jobs can run concurrently
+    static void ProcessMesh(const MeshImportJob& job, RawMeshData& data, std::vector<uint8_t>& materialIndexOut)
+    {
+        const aiMesh* mesh = job.Mesh;
+        const uint8_t materialIdx = static_cast<uint8_t>(mesh->mMaterialIndex);
+        const bool hasTexCoords = mesh->HasTextureCoords(0);
+        const bool hasNormals = mesh->HasNormals();
+
+        size_t vertex = job.VertexOffset;
         for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
         {
             const aiFace& face = mesh->mFaces[i];
@@ -33,111 +94,296 @@ namespace Titan
             };
 
             glm::vec2 uvs[3] = {
-                mesh->HasTextureCoords(0) ? glm::vec2(mesh->mTextureCoords[0][idx0].x, mesh->mTextureCoords[0][idx0].y)
-                                          : glm::vec2(0.0f),
-                mesh->HasTextureCoords(0) ? glm::vec2(mesh->mTextureCoords[0][idx1].x, mesh->mTextureCoords[0][idx1].y)
-                                          : glm::vec2(0.0f),
-                mesh->HasTextureCoords(0) ? glm::vec2(mesh->mTextureCoords[0][idx2].x, mesh->mTextureCoords[0][idx2].y)
-                                          : glm::vec2(0.0f)};
+                hasTexCoords ? glm::vec2(mesh->mTextureCoords[0][idx0].x, mesh->mTextureCoords[0][idx0].y)
+                             : glm::vec2(0.0f),
+                hasTexCoords ? glm::vec2(mesh->mTextureCoords[0][idx1].x, mesh->mTextureCoords[0][idx1].y)
+                             : glm::vec2(0.0f),
+                hasTexCoords ? glm::vec2(mesh->mTextureCoords[0][idx2].x, mesh->mTextureCoords[0][idx2].y)
+                             : glm::vec2(0.0f)};
 
             glm::vec3 n[3] = {
-                mesh->HasNormals() ? glm::vec3(mesh->mNormals[idx0].x, mesh->mNormals[idx0].y, mesh->mNormals[idx0].z)
-                                   : glm::vec3(0.0f),
-                mesh->HasNormals() ? glm::vec3(mesh->mNormals[idx1].x, mesh->mNormals[idx1].y, mesh->mNormals[idx1].z)
-                                   : glm::vec3(0.0f),
-                mesh->HasNormals() ? glm::vec3(mesh->mNormals[idx2].x, mesh->mNormals[idx2].y, mesh->mNormals[idx2].z)
-                                   : glm::vec3(0.0f)};
-
-            glm::vec3 edge1 = positions[1] - positions[0];
-            glm::vec3 edge2 = positions[2] - positions[0];
-            glm::vec2 deltaUV1 = uvs[1] - uvs[0];
-            glm::vec2 deltaUV2 = uvs[2] - uvs[0];
-            float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-            glm::vec3 tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
+                hasNormals ? glm::vec3(mesh->mNormals[idx0].x, mesh->mNormals[idx0].y, mesh->mNormals[idx0].z)
+                           : glm::vec3(0.0f),
+                hasNormals ? glm::vec3(mesh->mNormals[idx1].x, mesh->mNormals[idx1].y, mesh->mNormals[idx1].z)
+                           : glm::vec3(0.0f),
+                hasNormals ? glm::vec3(mesh->mNormals[idx2].x, mesh->mNormals[idx2].y, mesh->mNormals[idx2].z)
+                           : glm::vec3(0.0f)};
 
             for (int j = 0; j < 3; ++j)
             {
-                data.Positions.push_back(positions[j]);
-                data.Normals.push_back(n[j]);
-                data.TexCoords.push_back(uvs[j]);
-                data.Tangents.push_back(tangent);
-                materialIndexOut.push_back(materialIdx);
+                data.Positions[vertex] = positions[j];
+                data.Normals[vertex] = n[j];
+                data.TexCoords[vertex] = uvs[j];
+                materialIndexOut[vertex] = materialIdx;
+                vertex++;
             }
         }
+
+        TI_CORE_ASSERT(vertex == job.VertexOffset + job.VertexCount, "Mesh import slice overrun!");
     }
 
-    static void ProcessNode(aiNode* node, const aiScene* scene, RawMeshData& data,
-                            std::vector<uint8_t>& materialIndexOut)
+    // Collects meshes in node traversal order so the output layout matches the old serial import
+    static void GatherMeshes(const aiNode* node, const aiScene* scene, std::vector<MeshImportJob>& jobs)
     {
         for (unsigned int i = 0; i < node->mNumMeshes; ++i)
-        {
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            uint8_t matIndex = static_cast<uint8_t>(mesh->mMaterialIndex);
-            ProcessMesh(mesh, data, materialIndexOut, matIndex);
-        }
+            jobs.push_back({scene->mMeshes[node->mMeshes[i]]});
 
         for (unsigned int i = 0; i < node->mNumChildren; ++i)
-            ProcessNode(node->mChildren[i], scene, data, materialIndexOut);
+            GatherMeshes(node->mChildren[i], scene, jobs);
     }
-    struct Vec3Hash
+
+    static void ProcessNode(const aiNode* node, const aiScene* scene, RawMeshData& data,
+                            std::vector<uint8_t>& materialIndexOut)
     {
-        size_t operator()(const glm::vec3& v) const
+        TI_PROFILE_FUNCTION();
+
+        std::vector<MeshImportJob> jobs;
+        GatherMeshes(node, scene, jobs);
+
+        JobSystem::ParallelFor((uint32_t)jobs.size(), 1,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                       jobs[i].VertexCount = CountTriangleVertices(jobs[i].Mesh);
+                               });
+
+        size_t totalVertices = 0;
+        for (auto& job : jobs)
         {
-            size_t hx = std::hash<float>()(v.x);
-            size_t hy = std::hash<float>()(v.y);
-            size_t hz = std::hash<float>()(v.z);
-            return hx ^ (hy << 1) ^ (hz << 2);
+            job.VertexOffset = totalVertices;
+            totalVertices += job.VertexCount;
         }
-    };
 
-    void ComputeSmoothNormals(std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals)
-    {
-        std::unordered_map<glm::vec3, glm::vec3, Vec3Hash> normalMap;
+        data.Positions.resize(totalVertices);
+        data.Normals.resize(totalVertices);
+        data.TexCoords.resize(totalVertices);
+        materialIndexOut.resize(totalVertices);
+
+        JobSystem::ParallelFor((uint32_t)jobs.size(), 1,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                       ProcessMesh(jobs[i], data, materialIndexOut);
+                               });
+    }
 
-        for (size_t i = 0; i < positions.size(); i++)
-            normalMap[positions[i]] += normals[i];
+    // Sorted vertex order where welded vertices are contiguous: Runs[i]..Runs[i + 1] index one group in Order
+    struct WeldGroups
+    {
+        std::vector<uint32_t> Order;
+        std::vector<uint32_t> Runs;
+    };
 
-        for (size_t i = 0; i < positions.size(); i++)
-            normals[i] = glm::normalize(normalMap[positions[i]]);
+    // Welds compare the bit patterns of the attributes, which orders NaNs from malformed imports as well.
+    // Only equality matters for grouping, the two zeros are folded so they still weld.
+    static uint32_t WeldKey(float value)
+    {
+        return value == 0.0f ? 0u : std::bit_cast<uint32_t>(value);
     }
 
-    void ComputeTangents(const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& uvs,
-                         const std::vector<uint32_t>& indices, std::vector<glm::vec3>& tangents)
+    // Merge sort on the job system, std::execution::par would need TBB under libstdc++, which is not linked.
+    // Each level of the merge is one ParallelFor, only the last one merges on a single thread.
+    template <typename Less>
+    static void ParallelSort(std::vector<uint32_t>& values, Less less)
     {
-        tangents.resize(positions.size(), glm::vec3(0.0f));
-
-        for (size_t i = 0; i < indices.size(); i += 3)
+        const size_t count = values.size();
+        const uint32_t chunkCount = (uint32_t)((count + s_WeldSortChunkSize - 1) / s_WeldSortChunkSize);
+        JobSystem::ParallelFor(chunkCount, 1,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                   {
+                                       const size_t first = i * s_WeldSortChunkSize;
+                                       const size_t last = (std::min)(first + s_WeldSortChunkSize, count);
+                                       std::sort(values.begin() + first, values.begin() + last, less);
+                                   }
+                               });
+
+        std::vector<uint32_t> merged(count);
+        for (size_t width = s_WeldSortChunkSize; width < count; width *= 2)
         {
-            uint32_t i0 = indices[i];
-            uint32_t i1 = indices[i + 1];
-            uint32_t i2 = indices[i + 2];
+            const uint32_t pairCount = (uint32_t)((count + 2 * width - 1) / (2 * width));
+            JobSystem::ParallelFor(pairCount, 1,
+                                   [&](uint32_t begin, uint32_t end)
+                                   {
+                                       for (uint32_t i = begin; i < end; i++)
+                                       {
+                                           const size_t first = i * 2 * width;
+                                           const size_t middle = (std::min)(first + width, count);
+                                           const size_t last = (std::min)(first + 2 * width, count);
+                                           std::merge(values.begin() + first, values.begin() + middle,
+                                                      values.begin() + middle, values.begin() + last,
+                                                      merged.begin() + first, less);
+                                       }
+                                   });
+            values.swap(merged);
+        }
+    }
 
-            const glm::vec3& p0 = positions[i0];
-            const glm::vec3& p1 = positions[i1];
-            const glm::vec3& p2 = positions[i2];
+    template <typename Less>
+    static WeldGroups WeldVertices(size_t count, Less less)
+    {
+        WeldGroups groups;
+        groups.Order.resize(count);
+        std::iota(groups.Order.begin(), groups.Order.end(), 0u);
+        ParallelSort(groups.Order, less);
 
-            const glm::vec2& uv0 = uvs[i0];
-            const glm::vec2& uv1 = uvs[i1];
-            const glm::vec2& uv2 = uvs[i2];
+        // Keys are equal when neither sorts before the other
+        for (uint32_t i = 0; i < (uint32_t)count; i++)
+        {
+            if (i == 0 || less(groups.Order[i - 1], groups.Order[i]))
+                groups.Runs.push_back(i);
+        }
+        groups.Runs.push_back((uint32_t)count);
+        return groups;
+    }
 
-            glm::vec3 edge1 = p1 - p0;
-            glm::vec3 edge2 = p2 - p0;
+    // Runs every group of a weld on the job system, fn(const uint32_t* begin, const uint32_t* end)
+    template <typename Fn>
+    static void ForEachWeldGroup(const WeldGroups& groups, Fn fn)
+    {
+        if (groups.Runs.size() < 2)
+            return;
+
+        const uint32_t groupCount = (uint32_t)groups.Runs.size() - 1;
+        JobSystem::ParallelFor(groupCount, s_WeldGroupBatchSize,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                   {
+                                       const uint32_t* order = groups.Order.data();
+                                       fn(order + groups.Runs[i], order + groups.Runs[i + 1]);
+                                   }
+                               });
+    }
 
-            glm::vec2 deltaUV1 = uv1 - uv0;
-            glm::vec2 deltaUV2 = uv2 - uv0;
+    // Interior angle of the triangle at the given soup vertex, zero for degenerate corners
+    static float CornerAngle(const std::vector<glm::vec3>& positions, uint32_t vertex, glm::vec3& faceNormalOut)
+    {
+        const uint32_t first = vertex - vertex % 3;
+        const uint32_t corner = vertex - first;
+        const glm::vec3& p = positions[vertex];
+        glm::vec3 e0 = positions[first + (corner + 1) % 3] - p;
+        glm::vec3 e1 = positions[first + (corner + 2) % 3] - p;
+
+        glm::vec3 cross = glm::cross(e0, e1);
+        float crossLength = glm::length(cross);
+        if (crossLength <= 1e-20f)
+        {
+            faceNormalOut = glm::vec3(0.0f);
+            return 0.0f;
+        }
 
-            float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
+        faceNormalOut = cross / crossLength;
+        return std::atan2(crossLength, glm::dot(e0, e1));
+    }
 
-            glm::vec3 tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
+    static glm::vec3 AnyPerpendicular(const glm::vec3& n)
+    {
+        glm::vec3 axis = std::abs(n.x) > 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        return glm::normalize(glm::cross(n, axis));
+    }
 
-            tangents[i0] += tangent;
-            tangents[i1] += tangent;
-            tangents[i2] += tangent;
-        }
+    // Smooths normals across vertices that share a position, weighting each face by its corner angle.
+    // The incoming normals are only kept where every adjacent face is degenerate.
+    static void ComputeSmoothNormals(const std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals)
+    {
+        TI_PROFILE_FUNCTION();
+
+        WeldGroups groups = WeldVertices(positions.size(),
+                                         [&](uint32_t a, uint32_t b)
+                                         {
+                                             const glm::vec3& pa = positions[a];
+                                             const glm::vec3& pb = positions[b];
+                                             return std::make_tuple(WeldKey(pa.x), WeldKey(pa.y), WeldKey(pa.z)) <
+                                                    std::make_tuple(WeldKey(pb.x), WeldKey(pb.y), WeldKey(pb.z));
+                                         });
+
+        ForEachWeldGroup(groups,
+                         [&](const uint32_t* begin, const uint32_t* end)
+                         {
+                             glm::vec3 sum(0.0f);
+                             for (const uint32_t* it = begin; it != end; ++it)
+                             {
+                                 glm::vec3 faceNormal;
+                                 float angle = CornerAngle(positions, *it, faceNormal);
+                                 sum += faceNormal * angle;
+                             }
+
+                             if (glm::dot(sum, sum) <= 1e-20f)
+                                 return;
+
+                             glm::vec3 normal = glm::normalize(sum);
+                             for (const uint32_t* it = begin; it != end; ++it)
+                                 normals[*it] = normal;
+                         });
+    }
 
-        // Normalize
-        for (auto& t : tangents)
-            t = glm::normalize(t);
+    // Per-vertex tangents in the spirit of MikkTSpace: angle-weighted face tangents are accumulated over vertices
+    // sharing position, normal and UV, then Gram-Schmidt orthogonalized against the normal. Faces with degenerate
+    // UVs contribute nothing instead of producing NaN, and vertices left without a tangent get any perpendicular.
+    static void ComputeTangents(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals,
+                                const std::vector<glm::vec2>& uvs, std::vector<glm::vec3>& tangents)
+    {
+        TI_PROFILE_FUNCTION();
+
+        tangents.resize(positions.size());
+
+        WeldGroups groups = WeldVertices(positions.size(),
+                                         [&](uint32_t a, uint32_t b)
+                                         {
+                                             const glm::vec3& pa = positions[a];
+                                             const glm::vec3& pb = positions[b];
+                                             const glm::vec3& na = normals[a];
+                                             const glm::vec3& nb = normals[b];
+                                             const glm::vec2& ta = uvs[a];
+                                             const glm::vec2& tb = uvs[b];
+                                             auto key = [](const glm::vec3& p, const glm::vec3& n, const glm::vec2& t)
+                                             {
+                                                 return std::make_tuple(WeldKey(p.x), WeldKey(p.y), WeldKey(p.z),
+                                                                        WeldKey(n.x), WeldKey(n.y), WeldKey(n.z),
+                                                                        WeldKey(t.x), WeldKey(t.y));
+                                             };
+                                             return key(pa, na, ta) < key(pb, nb, tb);
+                                         });
+
+        ForEachWeldGroup(groups,
+                         [&](const uint32_t* begin, const uint32_t* end)
+                         {
+                             glm::vec3 sum(0.0f);
+                             for (const uint32_t* it = begin; it != end; ++it)
+                             {
+                                 const uint32_t first = *it - *it % 3;
+                                 glm::vec3 edge1 = positions[first + 1] - positions[first];
+                                 glm::vec3 edge2 = positions[first + 2] - positions[first];
+                                 glm::vec2 deltaUV1 = uvs[first + 1] - uvs[first];
+                                 glm::vec2 deltaUV2 = uvs[first + 2] - uvs[first];
+
+                                 float det = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+                                 if (std::abs(det) <= 1e-12f)
+                                     continue;
+
+                                 glm::vec3 faceTangent = (deltaUV2.y * edge1 - deltaUV1.y * edge2) / det;
+                                 float faceTangentLength = glm::length(faceTangent);
+                                 if (faceTangentLength <= 1e-20f)
+                                     continue;
+
+                                 glm::vec3 faceNormal;
+                                 float angle = CornerAngle(positions, *it, faceNormal);
+                                 sum += faceTangent / faceTangentLength * angle;
+                             }
+
+                             const glm::vec3& n = normals[*begin];
+                             glm::vec3 tangent = sum - n * glm::dot(n, sum);
+                             if (glm::dot(tangent, tangent) > 1e-20f)
+                                 tangent = glm::normalize(tangent);
+                             else
+                                 tangent = glm::dot(n, n) > 0.0f ? AnyPerpendicular(glm::normalize(n))
+                                                                 : glm::vec3(1.0f, 0.0f, 0.0f);
+
+                             for (const uint32_t* it = begin; it != end; ++it)
+                                 tangents[*it] = tangent;
+                         });
     }
 
     Ref<Mesh> Mesh::CreateQuad()
@@ -178,6 +424,7 @@ namespace Titan
         material->Name = "Material 1";
         mesh->m_Materials.push_back(material);
         mesh->m_FilePath = "quad";
+        mesh->ComputeBounds();
         return mesh;
     }
 
@@ -268,6 +515,7 @@ namespace Titan
         material->Name = "Material 1";
         mesh->m_Materials.push_back(material);
         mesh->m_FilePath = "cube";
+        mesh->ComputeBounds();
         return mesh;
     }
 
@@ -278,10 +526,20 @@ namespace Titan
         if (filepath == "cube")
             return CreateCube();
 
+        Timer timer;
+        uint64_t cacheKey = MeshCache::ComputeKey(s_ImportFlags);
+        if (Ref<Mesh> cooked = MeshCache::Load(filepath, cacheKey))
+        {
+            TI_CORE_INFO("Loaded cooked mesh {} ({} vertices) in {:.2f}ms", filepath, cooked->m_Positions.size(),
+                         timer.ElapsedMillis());
+            return cooked;
+        }
+
+        // The importer takes ownership of its IO handler
+        auto* ioSystem = new RecordingIOSystem();
         Assimp::Importer importer;
-        const aiScene* scene =
-            importer.ReadFile(filepath, aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace |
-                                            aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality);
+        importer.SetIOHandler(ioSystem);
+        const aiScene* scene = importer.ReadFile(filepath, s_ImportFlags);
 
         auto mesh = CreateRef<Mesh>();
         if (!scene || !scene->mRootNode)
@@ -314,15 +572,69 @@ namespace Titan
         }
 
         ProcessNode(scene->mRootNode, scene, data, materialIndices);
+
+        Timer kernelTimer;
         ComputeSmoothNormals(data.Positions, data.Normals);
+        ComputeTangents(data.Positions, data.Normals, data.TexCoords, data.Tangents);
+        TI_CORE_TRACE("Generated normals and tangents for {} ({} vertices) in {:.2f}ms", filepath,
+                      data.Positions.size(), kernelTimer.ElapsedMillis());
 
         mesh->m_Positions = std::move(data.Positions);
         mesh->m_Normals = std::move(data.Normals);
         mesh->m_TexCoords = std::move(data.TexCoords);
         mesh->m_Tangents = std::move(data.Tangents);
         mesh->m_MaterialIndex = std::move(materialIndices);
+        mesh->ComputeBounds();
 
         mesh->m_FilePath = std::filesystem::relative(filepath).string();
+        TI_CORE_INFO("Imported mesh {} ({} vertices) in {:.2f}ms", filepath, mesh->m_Positions.size(),
+                     timer.ElapsedMillis());
+
+        MeshCache::Save(*mesh, filepath, cacheKey, ioSystem->GetFiles());
         return mesh;
     }
+
+    Ref<Mesh> Mesh::CreateFromTriangles(std::vector<glm::vec3> positions, std::vector<glm::vec2> texCoords)
+    {
+        TI_CORE_ASSERT(positions.size() % 3 == 0 && texCoords.size() == positions.size(),
+                       "Mesh::CreateFromTriangles - Expected a triangle list with one UV per vertex");
+
+        RawMeshData data;
+        data.Positions = std::move(positions);
+        data.TexCoords = std::move(texCoords);
+        data.Normals.resize(data.Positions.size());
+        ComputeSmoothNormals(data.Positions, data.Normals);
+        ComputeTangents(data.Positions, data.Normals, data.TexCoords, data.Tangents);
+
+        auto mesh = CreateRef<Mesh>();
+        mesh->m_MaterialIndex = std::vector<uint8_t>(data.Positions.size(), 0);
+        mesh->m_Positions = std::move(data.Positions);
+        mesh->m_Normals = std::move(data.Normals);
+        mesh->m_TexCoords = std::move(data.TexCoords);
+        mesh->m_Tangents = std::move(data.Tangents);
+
+        auto material = CreateRef<Material3D>();
+        material->Name = "Material 1";
+        mesh->m_Materials.push_back(material);
+        mesh->ComputeBounds();
+        return mesh;
+    }
+
+    void Mesh::ComputeBounds()
+    {
+        if (m_Positions.empty())
+        {
+            m_BoundsMin = m_BoundsMax = glm::vec3(0.0f);
+            return;
+        }
+
+        // Parenthesized to keep the min/max macros from Core.h out of the way
+        m_BoundsMin = glm::vec3((std::numeric_limits<float>::max)());
+        m_BoundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const auto& position : m_Positions)
+        {
+            m_BoundsMin = (glm::min)(m_BoundsMin, position);
+            m_BoundsMax = (glm::max)(m_BoundsMax, position);
+        }
+    }
 } // namespace Titan
\ No newline at end of file
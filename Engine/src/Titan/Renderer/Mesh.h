@@ -19,10 +19,14 @@ namespace Titan
         const std::vector<Ref<Material3D>>& GetMaterials() const { return m_Materials; }
         const Ref<Material3D>& GetMaterial(int index) const { return m_Materials[index]; }
         const std::string& GetFilePath() const { return m_FilePath; }
+        const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+        const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
 
         static Ref<Mesh> CreateQuad();
         static Ref<Mesh> CreateCube();
         static Ref<Mesh> Create(const std::string& filepath);
+        // Triangle list with one UV per vertex, smooth normals and tangents are generated the way imports do
+        static Ref<Mesh> CreateFromTriangles(std::vector<glm::vec3> positions, std::vector<glm::vec2> texCoords);
 
     private:
         std::vector<glm::vec3> m_Positions;
@@ -31,9 +35,14 @@ namespace Titan
         std::vector<glm::vec3> m_Tangents;
         std::vector<Ref<Material3D>> m_Materials;
         std::vector<uint8_t> m_MaterialIndex;
+        glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+        glm::vec3 m_BoundsMax = glm::vec3(0.0f);
 
         std::string m_FilePath;
 
+        void ComputeBounds();
+
         friend class Renderer3D;
+        friend class MeshCache;
     };
 } // namespace Titan
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "MeshCache.h"
+#include "Titan/PCH.h"
+#include "Titan/Utils/FileSystem.h"
+#include "Titan/Utils/Hash.h"
+
+namespace Titan
+{
+    static const std::filesystem::path s_CookedMeshDirectory = "cache/meshes";
+
+    // Bump whenever the layout below or the import pipeline in Mesh.cpp changes
+    static constexpr uint32_t s_CookedMeshVersion = 3;
+    static constexpr char s_CookedMeshMagic[4] = {'T', 'M', 'S', 'H'};
+    static constexpr uint64_t s_StreamAlignment = 16;
+
+    struct CookedMeshHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint64_t Key;
+
+        uint32_t VertexCount;
+        uint32_t MaterialCount;
+        uint32_t DependencyCount;
+
+        glm::vec3 BoundsMin;
+        glm::vec3 BoundsMax;
+
+        // Byte offsets from the start of the file
+        uint64_t PositionsOffset;
+        uint64_t NormalsOffset;
+        uint64_t TexCoordsOffset;
+        uint64_t TangentsOffset;
+        uint64_t MaterialIndicesOffset;
+        uint64_t MaterialNamesOffset; // [uint32 length, chars] * MaterialCount
+        uint64_t DependenciesOffset;  // [CookedDependency, chars] * DependencyCount
+    };
+
+    // A file the import read, the source first. Size and write time are checked on every load, the contents only
+    // when the write time moved.
+    struct CookedDependency
+    {
+        uint64_t Size;
+        int64_t WriteTime;
+        uint64_t ContentHash;
+        uint32_t PathLength;
+        uint32_t Padding;
+    };
+
+    enum class DependencyState
+    {
+        Unchanged,
+        Touched, // Written again with the same contents, by a checkout or a copy
+        Changed
+    };
+
+    static uint64_t AlignOffset(uint64_t offset)
+    {
+        return (offset + s_StreamAlignment - 1) & ~(s_StreamAlignment - 1);
+    }
+
+    static uint64_t HashFileContents(const std::string& path)
+    {
+        MappedFile file(path);
+        return file.IsValid() ? Hash::FNV1a(file.GetData(), file.GetSize()) : Hash::FNV1aOffsetBasis;
+    }
+
+    static int64_t GetWriteTime(const std::string& path, std::error_code& ec)
+    {
+        return (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    }
+
+    static DependencyState CheckDependency(const std::string& path, const CookedDependency& dependency)
+    {
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec || size != dependency.Size)
+            return DependencyState::Changed;
+
+        const int64_t writeTime = GetWriteTime(path, ec);
+        if (ec)
+            return DependencyState::Changed;
+        if (writeTime == dependency.WriteTime)
+            return DependencyState::Unchanged;
+
+        return HashFileContents(path) == dependency.ContentHash ? DependencyState::Touched
+                                                                : DependencyState::Changed;
+    }
+
+    uint64_t MeshCache::ComputeKey(uint64_t importSettings)
+    {
+        uint64_t key = Hash::Combine(Hash::FNV1aOffsetBasis, s_CookedMeshVersion);
+        return Hash::Combine(key, importSettings);
+    }
+
+    std::filesystem::path MeshCache::GetCookedPath(const std::string& sourcePath)
+    {
+        std::string normalized = std::filesystem::path(sourcePath).lexically_normal().generic_string();
+        uint64_t pathHash = Hash::FNV1a(normalized);
+
+        std::string filename =
+            fmt::format("{}.{:016x}.tmesh", std::filesystem::path(sourcePath).filename().string(), pathHash);
+        return s_CookedMeshDirectory / filename;
+    }
+
+    Ref<Mesh> MeshCache::Load(const std::string& sourcePath, uint64_t key)
+    {
+        TI_PROFILE_FUNCTION();
+
+        MappedFile file(GetCookedPath(sourcePath));
+        if (!file.IsValid() || file.GetSize() < sizeof(CookedMeshHeader))
+            return nullptr;
+
+        const uint8_t* data = file.GetData();
+        CookedMeshHeader header;
+        memcpy(&header, data, sizeof(CookedMeshHeader));
+
+        if (memcmp(header.Magic, s_CookedMeshMagic, sizeof(header.Magic)) != 0 ||
+            header.Version != s_CookedMeshVersion)
+            return nullptr;
+
+        if (header.Key != key)
+        {
+            TI_CORE_TRACE("Cooked mesh for {} is stale", sourcePath);
+            return nullptr;
+        }
+
+        auto inBounds = [&](uint64_t offset, uint64_t size) { return offset + size <= file.GetSize(); };
+
+        // A changed source, buffer or material library makes the whole entry stale
+        std::vector<std::string> dependencies;
+        bool touched = false;
+        uint64_t offset = header.DependenciesOffset;
+        for (uint32_t i = 0; i < header.DependencyCount; i++)
+        {
+            CookedDependency dependency;
+            if (!inBounds(offset, sizeof(CookedDependency)))
+                return nullptr;
+            memcpy(&dependency, data + offset, sizeof(CookedDependency));
+            offset += sizeof(CookedDependency);
+
+            if (!inBounds(offset, dependency.PathLength))
+                return nullptr;
+            const std::string& path =
+                dependencies.emplace_back(reinterpret_cast<const char*>(data + offset), dependency.PathLength);
+            offset += dependency.PathLength;
+
+            const DependencyState state = CheckDependency(path, dependency);
+            if (state == DependencyState::Changed)
+            {
+                TI_CORE_TRACE("Cooked mesh for {} is stale, {} changed", sourcePath, path);
+                return nullptr;
+            }
+            touched |= state == DependencyState::Touched;
+        }
+
+        const uint64_t vertexCount = header.VertexCount;
+        if (!inBounds(header.PositionsOffset, vertexCount * sizeof(glm::vec3)) ||
+            !inBounds(header.NormalsOffset, vertexCount * sizeof(glm::vec3)) ||
+            !inBounds(header.TexCoordsOffset, vertexCount * sizeof(glm::vec2)) ||
+            !inBounds(header.TangentsOffset, vertexCount * sizeof(glm::vec3)) ||
+            !inBounds(header.MaterialIndicesOffset, vertexCount * sizeof(uint8_t)))
+        {
+            TI_CORE_WARN("Cooked mesh for {} is truncated", sourcePath);
+            return nullptr;
+        }
+
+        auto mesh = CreateRef<Mesh>();
+
+        // The streams are stored exactly as the Mesh keeps them, so loading is a bulk copy out of the mapping
+        auto positions = reinterpret_cast<const glm::vec3*>(data + header.PositionsOffset);
+        auto normals = reinterpret_cast<const glm::vec3*>(data + header.NormalsOffset);
+        auto texCoords = reinterpret_cast<const glm::vec2*>(data + header.TexCoordsOffset);
+        auto tangents = reinterpret_cast<const glm::vec3*>(data + header.TangentsOffset);
+        auto materialIndices = data + header.MaterialIndicesOffset;
+
+        if (std::any_of(materialIndices, materialIndices + vertexCount,
+                        [&](uint8_t index) { return index >= header.MaterialCount; }))
+        {
+            TI_CORE_WARN("Cooked mesh for {} has material indices past its {} materials", sourcePath,
+                         header.MaterialCount);
+            return nullptr;
+        }
+
+        mesh->m_Positions.assign(positions, positions + vertexCount);
+        mesh->m_Normals.assign(normals, normals + vertexCount);
+        mesh->m_TexCoords.assign(texCoords, texCoords + vertexCount);
+        mesh->m_Tangents.assign(tangents, tangents + vertexCount);
+        mesh->m_MaterialIndex.assign(materialIndices, materialIndices + vertexCount);
+        mesh->m_BoundsMin = header.BoundsMin;
+        mesh->m_BoundsMax = header.BoundsMax;
+
+        offset = header.MaterialNamesOffset;
+        mesh->m_Materials.reserve(header.MaterialCount);
+        for (uint32_t i = 0; i < header.MaterialCount; i++)
+        {
+            uint32_t length = 0;
+            if (!inBounds(offset, sizeof(uint32_t)))
+                return nullptr;
+            memcpy(&length, data + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+
+            if (!inBounds(offset, length))
+                return nullptr;
+
+            auto material = CreateRef<Material3D>();
+            material->Name.assign(reinterpret_cast<const char*>(data + offset), length);
+            mesh->m_Materials.push_back(material);
+            offset += length;
+        }
+
+        mesh->m_FilePath = std::filesystem::relative(sourcePath).string();
+
+        // Stores the new write times, so the contents of touched files are not hashed on every load.
+        // The mapping has to go first, the entry is replaced by renaming over it.
+        if (touched)
+        {
+            file.Close();
+            dependencies.erase(dependencies.begin());
+            Save(*mesh, sourcePath, key, dependencies);
+        }
+        return mesh;
+    }
+
+    bool MeshCache::Save(const Mesh& mesh, const std::string& sourcePath, uint64_t key,
+                         const std::vector<std::string>& dependencies)
+    {
+        TI_PROFILE_FUNCTION();
+
+        // The source goes first, importers open it too so it is dropped from the rest
+        std::vector<std::string> paths = {std::filesystem::path(sourcePath).lexically_normal().generic_string()};
+        for (const std::string& dependency : dependencies)
+        {
+            std::string path = std::filesystem::path(dependency).lexically_normal().generic_string();
+            if (std::find(paths.begin(), paths.end(), path) == paths.end())
+                paths.push_back(std::move(path));
+        }
+
+        std::vector<CookedDependency> records(paths.size());
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            std::error_code sizeError, timeError;
+            records[i].Size = std::filesystem::file_size(paths[i], sizeError);
+            records[i].WriteTime = GetWriteTime(paths[i], timeError);
+            if (sizeError || timeError)
+            {
+                TI_CORE_WARN("Not caching mesh {}, could not read {}", sourcePath, paths[i]);
+                return false;
+            }
+            records[i].ContentHash = HashFileContents(paths[i]);
+            records[i].PathLength = (uint32_t)paths[i].size();
+        }
+
+        const uint32_t vertexCount = (uint32_t)mesh.m_Positions.size();
+        TI_CORE_ASSERT(mesh.m_Normals.size() == vertexCount && mesh.m_TexCoords.size() == vertexCount &&
+                           mesh.m_Tangents.size() == vertexCount && mesh.m_MaterialIndex.size() == vertexCount,
+                       "Mesh streams have mismatched sizes!");
+
+        CookedMeshHeader header = {};
+        memcpy(header.Magic, s_CookedMeshMagic, sizeof(header.Magic));
+        header.Version = s_CookedMeshVersion;
+        header.Key = key;
+        header.VertexCount = vertexCount;
+        header.MaterialCount = (uint32_t)mesh.m_Materials.size();
+        header.DependencyCount = (uint32_t)paths.size();
+        header.BoundsMin = mesh.m_BoundsMin;
+        header.BoundsMax = mesh.m_BoundsMax;
+
+        uint64_t offset = AlignOffset(sizeof(CookedMeshHeader));
+        header.PositionsOffset = offset;
+        offset = AlignOffset(offset + vertexCount * sizeof(glm::vec3));
+        header.NormalsOffset = offset;
+        offset = AlignOffset(offset + vertexCount * sizeof(glm::vec3));
+        header.TexCoordsOffset = offset;
+        offset = AlignOffset(offset + vertexCount * sizeof(glm::vec2));
+        header.TangentsOffset = offset;
+        offset = AlignOffset(offset + vertexCount * sizeof(glm::vec3));
+        header.MaterialIndicesOffset = offset;
+        offset = AlignOffset(offset + vertexCount * sizeof(uint8_t));
+        header.MaterialNamesOffset = offset;
+        for (const auto& material : mesh.m_Materials)
+            offset += sizeof(uint32_t) + material->Name.size();
+        header.DependenciesOffset = offset;
+
+        std::filesystem::path cookedPath = GetCookedPath(sourcePath);
+        std::error_code ec;
+        std::filesystem::create_directories(cookedPath.parent_path(), ec);
+
+        // Write to a temporary file first so a crash mid-write never leaves a valid looking but broken cache entry
+        std::filesystem::path tempPath = cookedPath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                TI_CORE_WARN("Could not write cooked mesh {}", cookedPath.string());
+                return false;
+            }
+
+            auto writeStream = [&out](uint64_t streamOffset, const void* streamData, uint64_t size)
+            {
+                static const char padding[s_StreamAlignment] = {};
+                uint64_t position = (uint64_t)out.tellp();
+                if (streamOffset > position)
+                    out.write(padding, streamOffset - position);
+                if (size)
+                    out.write(reinterpret_cast<const char*>(streamData), size);
+            };
+
+            writeStream(0, &header, sizeof(CookedMeshHeader));
+            writeStream(header.PositionsOffset, mesh.m_Positions.data(), vertexCount * sizeof(glm::vec3));
+            writeStream(header.NormalsOffset, mesh.m_Normals.data(), vertexCount * sizeof(glm::vec3));
+            writeStream(header.TexCoordsOffset, mesh.m_TexCoords.data(), vertexCount * sizeof(glm::vec2));
+            writeStream(header.TangentsOffset, mesh.m_Tangents.data(), vertexCount * sizeof(glm::vec3));
+            writeStream(header.MaterialIndicesOffset, mesh.m_MaterialIndex.data(), vertexCount * sizeof(uint8_t));
+            writeStream(header.MaterialNamesOffset, nullptr, 0);
+
+            for (const auto& material : mesh.m_Materials)
+            {
+                uint32_t length = (uint32_t)material->Name.size();
+                out.write(reinterpret_cast<const char*>(&length), sizeof(uint32_t));
+                out.write(material->Name.data(), length);
+            }
+
+            for (size_t i = 0; i < paths.size(); i++)
+            {
+                out.write(reinterpret_cast<const char*>(&records[i]), sizeof(CookedDependency));
+                out.write(paths[i].data(), paths[i].size());
+            }
+
+            if (!out)
+            {
+                TI_CORE_WARN("Could not write cooked mesh {}", cookedPath.string());
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, cookedPath, ec);
+        if (ec)
+        {
+            TI_CORE_WARN("Could not write cooked mesh {}: {}", cookedPath.string(), ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+} // namespace Titan
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Mesh.h"
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+    // Cooked binary mesh cache.
+    // Imported meshes are written to cache/meshes as flat vertex streams and loaded back through a memory mapping,
+    // so subsequent loads skip Assimp and the normal/tangent generation entirely.
+    class TI_API MeshCache
+    {
+    public:
+        // Key derived from the import settings and the cooker version. The files an import read are recorded in
+        // the cooked mesh itself and checked by Load.
+        static uint64_t ComputeKey(uint64_t importSettings);
+
+        // Returns nullptr if there is no cooked mesh for this source, or the cooked mesh is stale or damaged
+        static Ref<Mesh> Load(const std::string& sourcePath, uint64_t key);
+        // dependencies are the files the import read besides the source, like glTF buffers and OBJ materials
+        static bool Save(const Mesh& mesh, const std::string& sourcePath, uint64_t key,
+                         const std::vector<std::string>& dependencies);
+
+        static std::filesystem::path GetCookedPath(const std::string& sourcePath);
+    };
+} // namespace Titan
@@ -3,6 +3,7 @@
 #include "PBRRenderer.h"
 #include "Renderer2D.h"
 #include "SceneRenderer.h"
+#include "SpriteAtlas.h"
 #include "Titan/PCH.h"
 #include "Titan/Platform/OpenGL/OpenGLShader.h"
 
@@ -15,6 +16,7 @@ namespace Titan
         TI_PROFILE_FUNCTION();
         RenderCommand::Init();
         Renderer2D::Init();
+        SpriteAtlas::Init();
         GeometryRenderer::Init();
         PBRRenderer::Init();
         SceneRenderer::Init();
@@ -24,6 +26,7 @@ namespace Titan
     {
         PBRRenderer::Shutdown();
         GeometryRenderer::Shutdown();
+        SpriteAtlas::Shutdown();
         Renderer2D::Shutdown();
         SceneRenderer::Shutdown();
     }
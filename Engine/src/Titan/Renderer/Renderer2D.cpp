@@ -358,22 +358,7 @@ namespace Titan
         if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
             FlushAndReset();
 
-        int textureIndex = 0.0f;
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (*s_Data.TextureSlots[i].get() == *texture.get())
-            {
-                textureIndex = i;
-                break;
-            }
-        }
-
-        if (textureIndex == 0.0f)
-        {
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-            s_Data.TextureSlotIndex++;
-        }
+        int textureIndex = GetTextureSlot(texture);
 
         glm::vec3 transformedPositions[4];
         for (int i = 0; i < 4; i++)
@@ -416,6 +401,51 @@ namespace Titan
         s_Data.Stats.QuadCount++;
     }
 
+    void Renderer2D::DrawTransformedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture,
+                                         const glm::vec2& uvMin, const glm::vec2& uvMax, const glm::vec4& tintColor,
+                                         int entityID)
+    {
+        if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
+            FlushAndReset();
+
+        const int textureIndex = GetTextureSlot(texture);
+        const float tilingFactor = 1.0f;
+        const glm::vec2 texCoords[4] = {uvMin, {uvMax.x, uvMin.y}, uvMax, {uvMin.x, uvMax.y}};
+
+        for (int i = 0; i < 4; i++)
+        {
+            s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
+            s_Data.QuadVertexBufferPtr->Color = tintColor;
+            s_Data.QuadVertexBufferPtr->TexCoord = texCoords[i];
+            s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
+            s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
+            s_Data.QuadVertexBufferPtr->EntityID = entityID;
+            s_Data.QuadVertexBufferPtr++;
+        }
+
+        s_Data.QuadIndexCount += 6;
+
+        s_Data.Stats.QuadCount++;
+    }
+
+    int Renderer2D::GetTextureSlot(const Ref<Texture2D>& texture)
+    {
+        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+        {
+            if (*s_Data.TextureSlots[i].get() == *texture.get())
+                return i;
+        }
+
+        // Out of slots, draw what we have so far and start a new batch
+        if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
+            FlushAndReset();
+
+        int textureIndex = (int)s_Data.TextureSlotIndex;
+        s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+        s_Data.TextureSlotIndex++;
+        return textureIndex;
+    }
+
     void Renderer2D::DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness, float fade,
                                 int entityID)
     {
@@ -27,6 +27,10 @@ namespace Titan
         static void DrawTransformedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture,
                                         float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f),
                                         int entityID = -1);
+        // Draws a sub-rect of the texture, e.g. a sprite in an atlas page. No tiling, it would sample past the rect.
+        static void DrawTransformedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture,
+                                        const glm::vec2& uvMin, const glm::vec2& uvMax,
+                                        const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
 
         // Circles
         static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f,
@@ -58,6 +62,7 @@ namespace Titan
 
     private:
         static void FlushAndReset();
+        static int GetTextureSlot(const Ref<Texture2D>& texture);
     };
 
 } // namespace Titan
\ No newline at end of file
@@ -30,6 +30,8 @@ namespace Titan
         virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
         inline static API GetAPI() { return s_API; }
+        // None runs without a graphics context (headless), nothing may create GPU resources then
+        inline static void SetAPI(API api) { s_API = api; }
 
     private:
         static API s_API;
@@ -4,6 +4,7 @@
 #include "Titan/Renderer/PBRRenderer.h"
 #include "Titan/Renderer/RenderCommand.h"
 #include "Titan/Renderer/Renderer2D.h"
+#include "Titan/Renderer/SpriteAtlas.h"
 #include "Titan/Scene/Components.h"
 #include "Titan/Scene/Scene.h"
 
@@ -93,7 +94,8 @@ namespace Titan
             {
                 auto fb = graph.GetFramebuffer("GeometryBuffer");
 
-                auto meshView = s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, MeshRendererComponent>();
+                auto meshView =
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, MeshRendererComponent>();
                 bool hasMeshes = meshView.begin() != meshView.end();
 
                 if (!fb)
@@ -107,9 +109,9 @@ namespace Titan
 
                 for (auto entity : meshView)
                 {
-                    auto [transform, meshComp] = meshView.get<TransformComponent, MeshRendererComponent>(entity);
+                    auto [transform, meshComp] = meshView.get<WorldTransformComponent, MeshRendererComponent>(entity);
                     if (meshComp.MeshRef)
-                        GeometryRenderer::DrawMesh(meshComp.MeshRef, transform.GetTransform(), (uint32_t)entity);
+                        GeometryRenderer::DrawMesh(meshComp.MeshRef, transform.RenderMatrix, (uint32_t)entity);
                 }
 
                 GeometryRenderer::EndScene();
@@ -123,7 +125,8 @@ namespace Titan
                 auto fb = graph.GetFramebuffer("SceneFramebuffer");
                 auto gbuffer = graph.GetFramebuffer("GeometryBuffer");
 
-                auto meshView = s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, MeshRendererComponent>();
+                auto meshView =
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, MeshRendererComponent>();
                 bool hasMeshes = meshView.begin() != meshView.end();
 
                 if (!fb || !gbuffer)
@@ -134,10 +137,10 @@ namespace Titan
                 bool hasDirectionalLight = false;
                 glm::vec3 lightDirection;
                 auto dlView =
-                    s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, DirectionalLightComponent>();
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, DirectionalLightComponent>();
                 for (auto entity : dlView)
                 {
-                    auto [transform, dlComp] = dlView.get<TransformComponent, DirectionalLightComponent>(entity);
+                    auto [transform, dlComp] = dlView.get<WorldTransformComponent, DirectionalLightComponent>(entity);
                     hasDirectionalLight = true;
                     lightDirection = dlComp.Direction;
 
@@ -167,16 +170,40 @@ namespace Titan
                 Renderer2D::BeginScene(s_SRData->viewProjection);
 
                 auto spriteView =
-                    s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, SpriteRendererComponent>();
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, SpriteRendererComponent>();
                 for (auto entity : spriteView)
                 {
-                    auto [transform, sprite] = spriteView.get<TransformComponent, SpriteRendererComponent>(entity);
-
-                    if (sprite.Tex)
-                        Renderer2D::DrawTransformedQuad(transform.GetTransform(), sprite.Tex, 1.0f, sprite.Color,
+                    auto [transform, sprite] = spriteView.get<WorldTransformComponent, SpriteRendererComponent>(entity);
+
+                    // Pending sprites are drawn on their own until their pixels are in the atlas
+                    if (sprite.AtlasSource != sprite.Tex)
+                    {
+                        SpriteAtlas::Region region;
+                        const SpriteAtlas::Lookup lookup = SpriteAtlas::GetRegion(sprite.Tex, region);
+                        if (lookup == SpriteAtlas::Lookup::Atlased)
+                        {
+                            // The page backed texture takes over, so the standalone one can be freed
+                            sprite.Tex = region.Texture;
+                            sprite.AtlasSource = sprite.Tex;
+                            sprite.AtlasPage = region.Page;
+                            sprite.AtlasUVMin = region.UVMin;
+                            sprite.AtlasUVMax = region.UVMax;
+                        }
+                        else if (lookup == SpriteAtlas::Lookup::Standalone)
+                        {
+                            sprite.AtlasSource = sprite.Tex;
+                            sprite.AtlasPage = nullptr;
+                        }
+                    }
+
+                    if (sprite.AtlasPage)
+                        Renderer2D::DrawTransformedQuad(transform.RenderMatrix, sprite.AtlasPage, sprite.AtlasUVMin,
+                                                        sprite.AtlasUVMax, sprite.Color, (uint32_t)entity);
+                    else if (sprite.Tex)
+                        Renderer2D::DrawTransformedQuad(transform.RenderMatrix, sprite.Tex, 1.0f, sprite.Color,
                                                         (uint32_t)entity);
                     else
-                        Renderer2D::DrawTransformedQuad(transform.GetTransform(), sprite.Color, (uint32_t)entity);
+                        Renderer2D::DrawTransformedQuad(transform.RenderMatrix, sprite.Color, (uint32_t)entity);
                 }
 
                 Renderer2D::EndScene();
@@ -197,11 +224,11 @@ namespace Titan
                 Renderer2D::BeginScene(s_SRData->viewProjection);
 
                 auto circleView =
-                    s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, CircleRendererComponent>();
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, CircleRendererComponent>();
                 for (auto entity : circleView)
                 {
-                    auto [transform, circle] = circleView.get<TransformComponent, CircleRendererComponent>(entity);
-                    Renderer2D::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade,
+                    auto [transform, circle] = circleView.get<WorldTransformComponent, CircleRendererComponent>(entity);
+                    Renderer2D::DrawCircle(transform.RenderMatrix, circle.Color, circle.Thickness, circle.Fade,
                                            (uint32_t)entity);
                 }
 
@@ -227,29 +254,30 @@ namespace Titan
 
                 // Box Colliders
                 auto boxColliderView =
-                    s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, BoxCollider2DComponent>();
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, BoxCollider2DComponent>();
                 for (auto entity : boxColliderView)
                 {
                     auto [transform, collider] =
-                        boxColliderView.get<TransformComponent, BoxCollider2DComponent>(entity);
-                    Renderer2D::DrawRect(transform.GetTransform(), glm::vec4(0.0f, 0.9f, 0.0f, 1.0));
+                        boxColliderView.get<WorldTransformComponent, BoxCollider2DComponent>(entity);
+                    Renderer2D::DrawRect(transform.RenderMatrix, glm::vec4(0.0f, 0.9f, 0.0f, 1.0));
                 }
 
                 // Circle Colliders
                 auto circleColliderView =
-                    s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, CircleCollider2DComponent>();
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, CircleCollider2DComponent>();
                 for (auto entity : circleColliderView)
                 {
                     auto [transform, collider] =
-                        circleColliderView.get<TransformComponent, CircleCollider2DComponent>(entity);
-                    Renderer2D::DrawRect(transform.GetTransform(), glm::vec4(0.0f, 0.9f, 0.0f, 1.0));
+                        circleColliderView.get<WorldTransformComponent, CircleCollider2DComponent>(entity);
+                    Renderer2D::DrawRect(transform.RenderMatrix, glm::vec4(0.0f, 0.9f, 0.0f, 1.0));
                 }
 
-                auto cameraView = s_SRData->currentScene->GetAllEntitiesWith<TransformComponent, CameraComponent>();
+                auto cameraView =
+                    s_SRData->currentScene->GetAllEntitiesWith<WorldTransformComponent, CameraComponent>();
                 for (auto entity : cameraView)
                 {
-                    auto [transform, cc] = cameraView.get<TransformComponent, CameraComponent>(entity);
-                    Renderer2D::DrawCamera(transform.GetTransform());
+                    auto [transform, cc] = cameraView.get<WorldTransformComponent, CameraComponent>(entity);
+                    Renderer2D::DrawCamera(transform.RenderMatrix);
                 }
 
                 Renderer2D::DrawGrid(20.0f);
@@ -281,15 +309,15 @@ namespace Titan
         Camera* mainCamera = nullptr;
         glm::mat4 cameraTransform;
 
-        auto view = scene->GetAllEntitiesWith<TransformComponent, CameraComponent>();
+        auto view = scene->GetAllEntitiesWith<WorldTransformComponent, CameraComponent>();
         for (auto entity : view)
         {
-            auto& transform = view.get<TransformComponent>(entity);
+            auto& transform = view.get<WorldTransformComponent>(entity);
             auto& camera = view.get<CameraComponent>(entity);
             if (camera.Primary)
             {
                 mainCamera = &camera.Camera;
-                cameraTransform = transform.GetTransform();
+                cameraTransform = transform.RenderMatrix;
                 break;
             }
         }
@@ -0,0 +1,355 @@
+#include "SpriteAtlas.h"
+#include "Titan/Core/JobSystem.h"
+#include "Titan/PCH.h"
+#include "Titan/Scene/Assets.h"
+
+namespace Titan
+{
+    // Each sprite is surrounded by a copy of its own edge pixels so bilinear filtering never reaches a neighbour
+    static constexpr uint32_t s_SpritePadding = 1;
+
+    // Skyline bottom-left packer. The skyline is a list of segments that together span the page width,
+    // a rect is placed where its top edge ends up lowest.
+    class SkylinePacker
+    {
+    public:
+        SkylinePacker(uint32_t width, uint32_t height) : m_Width(width), m_Height(height)
+        {
+            m_Skyline.push_back({0, 0, width});
+        }
+
+        bool Insert(uint32_t width, uint32_t height, uint32_t& xOut, uint32_t& yOut)
+        {
+            size_t bestIndex = m_Skyline.size();
+            uint32_t bestTop = UINT32_MAX;
+            uint32_t bestWidth = UINT32_MAX;
+            uint32_t bestY = 0;
+
+            for (size_t i = 0; i < m_Skyline.size(); i++)
+            {
+                uint32_t y = 0;
+                if (!Fit(i, width, height, y))
+                    continue;
+
+                uint32_t top = y + height;
+                if (top < bestTop || (top == bestTop && m_Skyline[i].Width < bestWidth))
+                {
+                    bestIndex = i;
+                    bestTop = top;
+                    bestWidth = m_Skyline[i].Width;
+                    bestY = y;
+                }
+            }
+
+            if (bestIndex == m_Skyline.size())
+                return false;
+
+            Segment node = {m_Skyline[bestIndex].X, bestY + height, width};
+            m_Skyline.insert(m_Skyline.begin() + bestIndex, node);
+
+            // Trim the segments the new one now covers
+            for (size_t i = bestIndex + 1; i < m_Skyline.size();)
+            {
+                const uint32_t previousEnd = m_Skyline[i - 1].X + m_Skyline[i - 1].Width;
+                Segment& segment = m_Skyline[i];
+                if (segment.X >= previousEnd)
+                    break;
+
+                const uint32_t overlap = previousEnd - segment.X;
+                if (segment.Width <= overlap)
+                {
+                    m_Skyline.erase(m_Skyline.begin() + i);
+                    continue;
+                }
+
+                segment.X += overlap;
+                segment.Width -= overlap;
+                break;
+            }
+
+            for (size_t i = 0; i + 1 < m_Skyline.size();)
+            {
+                if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+                {
+                    m_Skyline[i].Width += m_Skyline[i + 1].Width;
+                    m_Skyline.erase(m_Skyline.begin() + i + 1);
+                }
+                else
+                {
+                    i++;
+                }
+            }
+
+            xOut = node.X;
+            yOut = bestY;
+            return true;
+        }
+
+    private:
+        struct Segment
+        {
+            uint32_t X, Y, Width;
+        };
+
+        // Height a rect starting at the given segment would rest at
+        bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& yOut) const
+        {
+            if (m_Skyline[index].X + width > m_Width)
+                return false;
+
+            uint32_t y = 0;
+            uint32_t remaining = width;
+            for (size_t i = index; remaining > 0 && i < m_Skyline.size(); i++)
+            {
+                y = (std::max)(y, m_Skyline[i].Y);
+                if (y + height > m_Height)
+                    return false;
+
+                remaining -= (std::min)(remaining, m_Skyline[i].Width);
+            }
+
+            yOut = y;
+            return true;
+        }
+
+    private:
+        uint32_t m_Width, m_Height;
+        std::vector<Segment> m_Skyline;
+    };
+
+    // A sprite's rect in its page. Everything is forwarded to the page, uploads land in the rect.
+    class AtlasTexture2D : public Texture2D
+    {
+    public:
+        AtlasTexture2D(const std::string& path, const Ref<Texture2D>& page, uint32_t x, uint32_t y, uint32_t width,
+                       uint32_t height)
+            : m_Path(path), m_Page(page), m_X(x), m_Y(y), m_Width(width), m_Height(height)
+        {
+        }
+
+        virtual uint32_t GetWidth() const override { return m_Width; }
+        virtual uint32_t GetHeight() const override { return m_Height; }
+        virtual void* GetNativeTexture() const override { return m_Page->GetNativeTexture(); }
+        virtual std::string GetPath() const override { return m_Path; }
+        virtual TextureSettings GetSettings() const override { return m_Page->GetSettings(); }
+
+        virtual void SetData(void* data, uint32_t size) override
+        {
+            TI_CORE_ASSERT(size == m_Width * m_Height * 4, "Data must be the entire sprite!");
+            m_Page->SetSubData(data, m_X, m_Y, m_Width, m_Height);
+        }
+
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override
+        {
+            TI_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region is outside of the sprite!");
+            m_Page->SetSubData(data, m_X + x, m_Y + y, width, height);
+        }
+
+        virtual void Bind(uint32_t slot = 0) const override { m_Page->Bind(slot); }
+
+        virtual uint64_t GetBindlessHandle() override { return m_Page->GetBindlessHandle(); }
+        virtual void MakeHandleResident() override { m_Page->MakeHandleResident(); }
+        virtual void MakeHandleNonResident() override { m_Page->MakeHandleNonResident(); }
+        virtual bool isValidBindlessHandle() override { return m_Page->isValidBindlessHandle(); }
+
+        virtual bool operator==(const Texture& other) const override
+        {
+            return GetNativeTexture() == other.GetNativeTexture();
+        }
+
+    private:
+        std::string m_Path;
+        Ref<Texture2D> m_Page;
+        uint32_t m_X, m_Y, m_Width, m_Height;
+    };
+
+    struct AtlasPage
+    {
+        Ref<Texture2D> Texture;
+        TextureSettings Settings;
+        SkylinePacker Packer = SkylinePacker(SpriteAtlas::PageSize, SpriteAtlas::PageSize);
+    };
+
+    struct PendingSprite
+    {
+        TextureImage Image;
+        TextureSettings Settings;
+        JobCounter Counter;
+    };
+
+    struct SpriteAtlasData
+    {
+        std::vector<AtlasPage> Pages;
+
+        // Keyed by source path, a null page marks textures that stay standalone
+        std::unordered_map<std::string, SpriteAtlas::Region> Regions;
+        // Decoding on the job system, the first lookup after the decode finished packs the sprite
+        std::unordered_map<std::string, Scope<PendingSprite>> Pending;
+    };
+
+    static SpriteAtlasData s_Data;
+
+    void SpriteAtlas::Init()
+    {
+        TI_PROFILE_FUNCTION();
+        s_Data.Pages.clear();
+        s_Data.Regions.clear();
+    }
+
+    void SpriteAtlas::Shutdown()
+    {
+        TI_PROFILE_FUNCTION();
+        for (auto& [path, sprite] : s_Data.Pending)
+            JobSystem::Wait(sprite->Counter);
+        s_Data.Pending.clear();
+        s_Data.Regions.clear();
+        s_Data.Pages.clear();
+    }
+
+    static bool CanAtlas(const Ref<Texture2D>& texture, const std::string& path)
+    {
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".svg" || !std::filesystem::exists(path))
+            return false;
+
+        return texture->GetWidth() > 0 && texture->GetHeight() > 0 &&
+               texture->GetWidth() <= SpriteAtlas::MaxSpriteSize && texture->GetHeight() <= SpriteAtlas::MaxSpriteSize;
+    }
+
+    // Main thread, the pixels were decoded by a job. Channels the image lacks read like they do from a standalone
+    // texture of that format: zero, with an opaque alpha.
+    static bool PackSprite(const std::string& path, const PendingSprite& sprite, SpriteAtlas::Region& regionOut)
+    {
+        TI_PROFILE_FUNCTION();
+
+        const TextureImage& image = sprite.Image;
+        if (!image.IsValid() || image.Channels == 0 || image.Channels > 4 || image.Width == 0 || image.Height == 0 ||
+            image.Width > SpriteAtlas::MaxSpriteSize || image.Height > SpriteAtlas::MaxSpriteSize)
+            return false;
+
+        const uint32_t width = image.Width;
+        const uint32_t height = image.Height;
+        const uint32_t paddedWidth = width + s_SpritePadding * 2;
+        const uint32_t paddedHeight = height + s_SpritePadding * 2;
+
+        uint32_t x = 0, y = 0;
+        AtlasPage* page = nullptr;
+        for (auto& candidate : s_Data.Pages)
+        {
+            if (candidate.Settings == sprite.Settings && candidate.Packer.Insert(paddedWidth, paddedHeight, x, y))
+            {
+                page = &candidate;
+                break;
+            }
+        }
+
+        if (!page)
+        {
+            AtlasPage& newPage = s_Data.Pages.emplace_back();
+            newPage.Settings = sprite.Settings;
+            newPage.Texture = Texture2D::Create(SpriteAtlas::PageSize, SpriteAtlas::PageSize, sprite.Settings);
+
+            std::vector<uint8_t> clear((size_t)SpriteAtlas::PageSize * SpriteAtlas::PageSize * 4, 0);
+            newPage.Texture->SetData(clear.data(), (uint32_t)clear.size());
+            TI_CORE_INFO("Created sprite atlas page {}", s_Data.Pages.size());
+
+            bool inserted = newPage.Packer.Insert(paddedWidth, paddedHeight, x, y);
+            TI_CORE_ASSERT(inserted, "Sprite does not fit into an empty atlas page!");
+            page = &newPage;
+        }
+
+        // Copy with the edge pixels extruded into the padding
+        const uint32_t channels = image.Channels;
+        std::vector<uint8_t> block((size_t)paddedWidth * paddedHeight * 4);
+        for (uint32_t py = 0; py < paddedHeight; py++)
+        {
+            const int sy = std::clamp((int)py - (int)s_SpritePadding, 0, (int)height - 1);
+            for (uint32_t px = 0; px < paddedWidth; px++)
+            {
+                const int sx = std::clamp((int)px - (int)s_SpritePadding, 0, (int)width - 1);
+                const uint8_t* src = &image.Pixels[((size_t)sy * width + sx) * channels];
+                uint8_t* dst = &block[((size_t)py * paddedWidth + px) * 4];
+                for (uint32_t c = 0; c < 4; c++)
+                    dst[c] = c < channels ? src[c] : (c == 3 ? 255 : 0);
+            }
+        }
+
+        page->Texture->SetSubData(block.data(), x, y, paddedWidth, paddedHeight);
+
+        const float texel = 1.0f / SpriteAtlas::PageSize;
+        regionOut.Page = page->Texture;
+        regionOut.UVMin = {(x + s_SpritePadding) * texel, (y + s_SpritePadding) * texel};
+        regionOut.UVMax = {(x + s_SpritePadding + width) * texel, (y + s_SpritePadding + height) * texel};
+        regionOut.Texture =
+            CreateRef<AtlasTexture2D>(path, page->Texture, x + s_SpritePadding, y + s_SpritePadding, width, height);
+        return true;
+    }
+
+    SpriteAtlas::Lookup SpriteAtlas::GetRegion(const Ref<Texture2D>& texture, Region& regionOut)
+    {
+        if (!texture)
+            return Lookup::Standalone;
+
+        if (FindRegion(texture, regionOut))
+            return Lookup::Atlased;
+
+        const std::string path = texture->GetPath();
+        if (s_Data.Regions.contains(path))
+            return Lookup::Standalone;
+
+        auto pending = s_Data.Pending.find(path);
+        if (pending == s_Data.Pending.end())
+        {
+            if (!CanAtlas(texture, path))
+            {
+                s_Data.Regions.emplace(path, Region());
+                return Lookup::Standalone;
+            }
+
+            // Decoding takes longer than a frame for larger sprites, so it stays off the render pass
+            PendingSprite* sprite = s_Data.Pending.emplace(path, CreateScope<PendingSprite>()).first->second.get();
+            sprite->Settings = texture->GetSettings();
+            JobSystem::Execute([sprite, path]() { sprite->Image = TextureImage::Decode(path); }, &sprite->Counter);
+            return Lookup::Pending;
+        }
+
+        if (!pending->second->Counter.IsDone())
+            return Lookup::Pending;
+
+        Region region;
+        if (!PackSprite(path, *pending->second, region))
+            region = Region();
+        s_Data.Pending.erase(pending);
+        s_Data.Regions.emplace(path, region);
+        if (!region.Page)
+            return Lookup::Standalone;
+
+        // Later loads create the texture anew instead of keeping the standalone one alive for sprites that no longer
+        // use it. Its current users hold on to it until they switch to the atlased texture.
+        if (AssetLibrary::Get<Texture2D>(path) == texture)
+            Assets::Unload(path);
+
+        regionOut = region;
+        return Lookup::Atlased;
+    }
+
+    bool SpriteAtlas::FindRegion(const Ref<Texture2D>& texture, Region& regionOut)
+    {
+        if (!texture)
+            return false;
+
+        auto it = s_Data.Regions.find(texture->GetPath());
+        if (it == s_Data.Regions.end() || !it->second.Page)
+            return false;
+
+        regionOut = it->second;
+        return true;
+    }
+
+    uint32_t SpriteAtlas::GetPageCount()
+    {
+        return (uint32_t)s_Data.Pages.size();
+    }
+
+} // namespace Titan
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Texture.h"
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    // Packs sprite textures into a few large atlas pages so 2D scenes batch into fewer texture slots.
+    // Sprites are added on demand. A new sprite goes into the first page with room and only its rect is uploaded,
+    // a page is only ever appended, never repacked. Pages share one set of texture settings, sprites only go into
+    // pages sampled the way their own texture was.
+    class TI_API SpriteAtlas
+    {
+    public:
+        static constexpr uint32_t PageSize = 2048;
+        // Larger sprites keep their own texture, they would waste most of a page
+        static constexpr uint32_t MaxSpriteSize = 512;
+
+        struct Region
+        {
+            Ref<Texture2D> Page;
+            glm::vec2 UVMin = {0.0f, 0.0f};
+            glm::vec2 UVMax = {1.0f, 1.0f};
+            // Stands in for the standalone texture, same path and size but backed by the page. Swapping it in lets
+            // the standalone texture go.
+            Ref<Texture2D> Texture;
+        };
+
+        enum class Lookup
+        {
+            Atlased,
+            Pending,   // Being decoded on the job system, ask again next frame
+            Standalone // No source file, too large or not a raster image
+        };
+
+        static void Init();
+        static void Shutdown();
+
+        // Adds the texture on its first lookup. The caller draws the texture itself unless it is atlased.
+        static Lookup GetRegion(const Ref<Texture2D>& texture, Region& regionOut);
+        // Only looks up textures that are already atlased, never adds one
+        static bool FindRegion(const Ref<Texture2D>& texture, Region& regionOut);
+
+        static uint32_t GetPageCount();
+    };
+
+} // namespace Titan
@@ -2,6 +2,9 @@
 #include "Titan/PCH.h"
 #include "Titan/Platform/OpenGL/OpenGLTexture.h"
 #include "Titan/Renderer/Renderer.h"
+#include "nanosvg.h"
+#include "nanosvgrast.h"
+#include "stb_image.h"
 
 namespace Titan
 {
@@ -20,6 +23,21 @@ namespace Titan
         return nullptr;
     }
 
+    Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height, TextureSettings settings)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:
+                TI_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+                return nullptr;
+            case RendererAPI::API::OpenGL:
+                return CreateRef<OpenGLTexture2D>(width, height, settings);
+        }
+
+        TI_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
     Ref<Texture2D> Texture2D::Create(const std::string& path, TextureSettings settings)
     {
         switch (Renderer::GetAPI())
@@ -35,4 +53,75 @@ namespace Titan
         return nullptr;
     }
 
+    Ref<Texture2D> Texture2D::Create(const TextureImage& image, TextureSettings settings)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:
+                TI_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+                return nullptr;
+            case RendererAPI::API::OpenGL:
+                return CreateRef<OpenGLTexture2D>(image, settings);
+        }
+
+        TI_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+    TextureImage TextureImage::Decode(const std::string& path)
+    {
+        TI_PROFILE_FUNCTION();
+
+        TextureImage image;
+        image.Path = path;
+
+        auto ext = path.substr(path.find_last_of(".") + 1);
+        for (auto& c : ext)
+            c = std::tolower(c);
+
+        if (ext == "svg")
+        {
+            NSVGimage* svg = nsvgParseFromFile(path.c_str(), "px", 96);
+            TI_CORE_ASSERT(svg, "Failed to load SVG!");
+            if (!svg)
+                return image;
+
+            image.Width = image.Height = 256;
+            image.Channels = 4;
+            image.Pixels.resize(image.Width * image.Height * 4);
+
+            NSVGrasterizer* rast = nsvgCreateRasterizer();
+            float scale = float(image.Width) / svg->width;
+            nsvgRasterize(rast, svg, 0, 0, scale, image.Pixels.data(), image.Width, image.Height, image.Width * 4);
+            nsvgDeleteRasterizer(rast);
+            nsvgDelete(svg);
+
+            // Flip vertically, a whole row at a time
+            const uint32_t rowBytes = image.Width * 4;
+            for (uint32_t y = 0; y < image.Height / 2; y++)
+            {
+                uint8_t* row = image.Pixels.data() + y * rowBytes;
+                std::swap_ranges(row, row + rowBytes, image.Pixels.data() + (image.Height - y - 1) * rowBytes);
+            }
+
+            return image;
+        }
+
+        // The per thread flag, images are decoded on several threads at once
+        stbi_set_flip_vertically_on_load_thread(1);
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        TI_CORE_ASSERT(data, "Failed to load image!");
+        if (!data)
+            return image;
+
+        image.Width = (uint32_t)width;
+        image.Height = (uint32_t)height;
+        image.Channels = (uint32_t)channels;
+        image.Pixels.assign(data, data + (size_t)width * height * channels);
+        stbi_image_free(data);
+
+        return image;
+    }
+
 } // namespace Titan
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Titan/Core.h"
 
@@ -18,6 +19,8 @@ namespace Titan
         virtual std::string GetPath() const = 0;
 
         virtual void SetData(void* data, uint32_t size) = 0;
+        // Uploads a tightly packed block into the given region, in the texture's data format
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
         virtual void Bind(uint32_t slot = 0) const = 0;
 
@@ -53,13 +56,35 @@ namespace Titan
         TextureFiltering MagFilter = TextureFiltering::Linear;
 
         TextureSettings() = default;
+
+        bool operator==(const TextureSettings& other) const = default;
+    };
+
+    // An image file decoded to pixels. Decoding needs no graphics context, loaders do it on worker threads and only
+    // create the texture on the main thread.
+    struct TI_API TextureImage
+    {
+        std::string Path;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t Channels = 0;
+        std::vector<uint8_t> Pixels; // Bottom row first
+
+        bool IsValid() const { return !Pixels.empty(); }
+
+        static TextureImage Decode(const std::string& path);
     };
 
     class TI_API Texture2D : public Texture
     {
     public:
         static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+        // Blank RGBA texture sampled with the given settings, filled later through SetData and SetSubData
+        static Ref<Texture2D> Create(uint32_t width, uint32_t height, TextureSettings settings);
         static Ref<Texture2D> Create(const std::string& path, TextureSettings settings = TextureSettings());
+        static Ref<Texture2D> Create(const TextureImage& image, TextureSettings settings = TextureSettings());
+
+        virtual TextureSettings GetSettings() const = 0;
     };
 
     namespace Utils
@@ -268,6 +268,20 @@ namespace Titan
             return meta;
         }
 
+        inline TextureSettings TextureSettingsFromMeta(const AssetMeta& meta)
+        {
+            TextureSettings settings;
+            if (meta.Properties.contains("WrapS"))
+                settings.HorizontalWrap = Utils::StringToTextureWrap(meta.Properties.at("WrapS"));
+            if (meta.Properties.contains("WrapT"))
+                settings.VerticalWrap = Utils::StringToTextureWrap(meta.Properties.at("WrapT"));
+            if (meta.Properties.contains("MinFilter"))
+                settings.MinFilter = Utils::StringToTextureFiltering(meta.Properties.at("MinFilter"));
+            if (meta.Properties.contains("MagFilter"))
+                settings.MagFilter = Utils::StringToTextureFiltering(meta.Properties.at("MagFilter"));
+            return settings;
+        }
+
         template <typename T>
         Ref<T> Load(const std::filesystem::path& path)
         {
@@ -281,16 +295,7 @@ namespace Titan
 
             if constexpr (std::is_same_v<T, Texture2D>)
             {
-                TextureSettings settings;
-                if (meta.Properties.contains("WrapS"))
-                    settings.HorizontalWrap = Utils::StringToTextureWrap(meta.Properties["WrapS"]);
-                if (meta.Properties.contains("WrapT"))
-                    settings.VerticalWrap = Utils::StringToTextureWrap(meta.Properties["WrapT"]);
-                if (meta.Properties.contains("MinFilter"))
-                    settings.MinFilter = Utils::StringToTextureFiltering(meta.Properties["MinFilter"]);
-                if (meta.Properties.contains("MagFilter"))
-                    settings.MagFilter = Utils::StringToTextureFiltering(meta.Properties["MagFilter"]);
-                asset = Texture2D::Create(std::filesystem::relative(path).string(), settings);
+                asset = Texture2D::Create(std::filesystem::relative(path).string(), TextureSettingsFromMeta(meta));
             }
             else if constexpr (std::is_same_v<T, Shader>)
             {
@@ -300,7 +305,11 @@ namespace Titan
             {
                 asset = CreateRef<Scene>();
                 SceneSerializer serializer(asset);
-                serializer.Deserialize(std::filesystem::relative(path).string());
+                std::string scenePath = std::filesystem::relative(path).string();
+                if (SceneSerializer::IsRuntimeScene(path))
+                    serializer.DeserializeRuntime(scenePath);
+                else
+                    serializer.Deserialize(scenePath);
             }
             else if constexpr (std::is_same_v<T, Physics2DMaterial>)
             {
@@ -321,6 +330,29 @@ namespace Titan
             return asset;
         }
 
+        // Creates a texture from pixels decoded ahead of time (SceneLoader decodes on worker threads), with the
+        // settings from its meta file
+        inline Ref<Texture2D> LoadFromImage(const std::filesystem::path& path, const TextureImage& image)
+        {
+            if (AssetLibrary::Exists(path))
+                return AssetLibrary::Get<Texture2D>(path);
+
+            AssetMeta meta = LoadMetaFromDisk<Texture2D>(path);
+            Ref<Texture2D> texture = Texture2D::Create(image, TextureSettingsFromMeta(meta));
+            if (texture)
+                AssetLibrary::Add(path, texture, meta);
+
+            return texture;
+        }
+
+        // Registers an asset that was created outside Load, loading it again returns this one
+        template <typename T>
+        void Add(const std::filesystem::path& path, const Ref<T>& asset)
+        {
+            if (asset && !AssetLibrary::Exists(path))
+                AssetLibrary::Add(path, asset, LoadMetaFromDisk<T>(path));
+        }
+
         inline void Unload(const std::filesystem::path& path)
         {
             if (AssetLibrary::Exists(path))
@@ -47,11 +47,40 @@ namespace Titan
         }
     };
 
+    // Parent/child links, by UUID so they survive Scene::Copy and serialization. A Parent of 0 is a root.
+    struct RelationshipComponent
+    {
+        UUID Parent = 0;
+        std::vector<UUID> Children;
+
+        RelationshipComponent() = default;
+        RelationshipComponent(const RelationshipComponent&) = default;
+    };
+
+    // World matrix cached by Scene::UpdateWorldTransforms, read this instead of calling GetTransform every pass
+    struct WorldTransformComponent
+    {
+        glm::mat4 Matrix{1.0f};
+        // What gets drawn. Moving physics bodies and their children sit between the last two steps here,
+        // Matrix and the TransformComponent hold the simulated pose.
+        glm::mat4 RenderMatrix{1.0f};
+
+        WorldTransformComponent() = default;
+        WorldTransformComponent(const WorldTransformComponent&) = default;
+    };
+
     struct SpriteRendererComponent
     {
         Ref<Texture2D> Tex;
         glm::vec4 Color{1.0f, 1.0f, 1.0f, 1.0f};
 
+        // Where Tex lives in the sprite atlas, resolved by the sprite pass whenever Tex changes. Once atlased, Tex is
+        // swapped for the page backed texture of the same path. AtlasPage stays null for textures drawn on their own.
+        Ref<Texture2D> AtlasSource;
+        Ref<Texture2D> AtlasPage;
+        glm::vec2 AtlasUVMin{0.0f, 0.0f};
+        glm::vec2 AtlasUVMax{1.0f, 1.0f};
+
         SpriteRendererComponent() = default;
         SpriteRendererComponent(const SpriteRendererComponent&) = default;
         SpriteRendererComponent(const Ref<Texture2D> texture, const glm::vec4& color) : Tex(texture), Color(color) {}
@@ -126,6 +155,13 @@ namespace Titan
         bool FixedRotation = false;
 
         void* RuntimeBody = nullptr;
+        // Body pose after the last applied fixed step and the one before it, rendering interpolates between them
+        glm::vec2 Position = {0.0f, 0.0f};
+        float Angle = 0.0f;
+        glm::vec2 PreviousPosition = {0.0f, 0.0f};
+        float PreviousAngle = 0.0f;
+        // Last step the body was awake in, bodies asleep for longer are skipped when writing transforms back
+        uint32_t MovedStep = 0;
 
         Rigidbody2DComponent() = default;
         Rigidbody2DComponent(const Rigidbody2DComponent&) = default;
@@ -0,0 +1,422 @@
+#include "DynamicBVH.h"
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    // Leaves are fattened by this much, so objects moving a little don't have to be reinserted
+    static constexpr float s_FatMargin = 0.1f;
+    // MoveProxies refits the whole tree once more than this share of the proxies moved
+    static constexpr float s_RefitShare = 0.25f;
+    // and rebuilds it once its area ratio grew by this factor since the last rebuild
+    static constexpr float s_RebuildGrowth = 1.5f;
+
+    int32_t DynamicBVH::AllocateNode()
+    {
+        int32_t node;
+        if (m_FreeList != NullNode)
+        {
+            node = m_FreeList;
+            m_FreeList = m_Nodes[node].Parent;
+        }
+        else
+        {
+            node = (int32_t)m_Nodes.size();
+            m_Nodes.emplace_back();
+        }
+
+        m_Nodes[node] = Node{};
+        m_Nodes[node].Height = 0;
+        return node;
+    }
+
+    void DynamicBVH::FreeNode(int32_t node)
+    {
+        m_Nodes[node].Parent = m_FreeList;
+        m_Nodes[node].Height = -1;
+        m_FreeList = node;
+    }
+
+    int32_t DynamicBVH::CreateProxy(const AABB& bounds, uint32_t userData)
+    {
+        const int32_t proxy = AllocateNode();
+        Node& node = m_Nodes[proxy];
+        node.Tight = bounds;
+        node.Bounds = bounds.Expanded(s_FatMargin);
+        node.UserData = userData;
+
+        InsertLeaf(proxy);
+        m_ProxyCount++;
+        return proxy;
+    }
+
+    void DynamicBVH::DestroyProxy(int32_t proxy)
+    {
+        TI_CORE_ASSERT(m_Nodes[proxy].IsLeaf() && m_Nodes[proxy].Height == 0, "Not a proxy");
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_ProxyCount--;
+    }
+
+    bool DynamicBVH::MoveProxy(int32_t proxy, const AABB& bounds)
+    {
+        Node& node = m_Nodes[proxy];
+        node.Tight = bounds;
+        if (node.Bounds.Contains(bounds))
+            return false;
+
+        RemoveLeaf(proxy);
+        m_Nodes[proxy].Bounds = bounds.Expanded(s_FatMargin);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicBVH::MoveProxies(std::span<const ProxyMove> moves)
+    {
+        TI_PROFILE_FUNCTION();
+
+        if (moves.size() < m_ProxyCount * s_RefitShare)
+        {
+            for (const ProxyMove& move : moves)
+                MoveProxy(move.Proxy, move.Bounds);
+            return;
+        }
+
+        // Reinserting this many leaves costs more than fixing up every internal node once
+        for (const ProxyMove& move : moves)
+        {
+            Node& node = m_Nodes[move.Proxy];
+            node.Tight = move.Bounds;
+            if (!node.Bounds.Contains(move.Bounds))
+                node.Bounds = move.Bounds.Expanded(s_FatMargin);
+        }
+
+        if (m_Root != NullNode)
+            Refit(m_Root);
+
+        // Refitting keeps the topology, which gets worse the further things moved from where they were inserted
+        const float areaRatio = GetAreaRatio();
+        if (m_RebuildAreaRatio <= 0.0f)
+            m_RebuildAreaRatio = areaRatio;
+        else if (areaRatio > m_RebuildAreaRatio * s_RebuildGrowth)
+            Rebuild();
+    }
+
+    void DynamicBVH::Refit(int32_t node)
+    {
+        // Balanced trees stay shallow enough to recurse
+        Node& current = m_Nodes[node];
+        if (current.IsLeaf())
+            return;
+
+        Refit(current.Child1);
+        Refit(current.Child2);
+        current.Bounds = AABB::Union(m_Nodes[current.Child1].Bounds, m_Nodes[current.Child2].Bounds);
+    }
+
+    void DynamicBVH::Rebuild()
+    {
+        TI_PROFILE_FUNCTION();
+
+        std::vector<int32_t> leaves;
+        leaves.reserve(m_ProxyCount);
+        for (int32_t i = 0; i < (int32_t)m_Nodes.size(); i++)
+        {
+            if (m_Nodes[i].Height < 0)
+                continue;
+
+            if (m_Nodes[i].IsLeaf())
+            {
+                // Refitted leaves may still carry fattened bounds from far away
+                m_Nodes[i].Bounds = m_Nodes[i].Tight.Expanded(s_FatMargin);
+                leaves.push_back(i);
+            }
+            else
+            {
+                FreeNode(i);
+            }
+        }
+
+        m_Root = leaves.empty() ? NullNode : BuildRange(leaves, 0, leaves.size());
+        if (m_Root != NullNode)
+            m_Nodes[m_Root].Parent = NullNode;
+
+        m_RebuildAreaRatio = GetAreaRatio();
+    }
+
+    int32_t DynamicBVH::BuildRange(std::vector<int32_t>& leaves, size_t begin, size_t end)
+    {
+        if (end - begin == 1)
+            return leaves[begin];
+
+        // Median split along the axis the centers are spread the most
+        glm::vec3 centerMin(std::numeric_limits<float>::max());
+        glm::vec3 centerMax(std::numeric_limits<float>::lowest());
+        for (size_t i = begin; i < end; i++)
+        {
+            const glm::vec3 center = m_Nodes[leaves[i]].Bounds.GetCenter();
+            centerMin = glm::min(centerMin, center);
+            centerMax = glm::max(centerMax, center);
+        }
+
+        const glm::vec3 spread = centerMax - centerMin;
+        const int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(leaves.begin() + begin, leaves.begin() + middle, leaves.begin() + end,
+                         [this, axis](int32_t a, int32_t b)
+                         { return m_Nodes[a].Bounds.GetCenter()[axis] < m_Nodes[b].Bounds.GetCenter()[axis]; });
+
+        // Allocation may grow m_Nodes, so nodes are only looked up once the children exist
+        const int32_t parent = AllocateNode();
+        const int32_t child1 = BuildRange(leaves, begin, middle);
+        const int32_t child2 = BuildRange(leaves, middle, end);
+
+        Node& node = m_Nodes[parent];
+        node.Child1 = child1;
+        node.Child2 = child2;
+        node.Bounds = AABB::Union(m_Nodes[child1].Bounds, m_Nodes[child2].Bounds);
+        node.Height = 1 + (std::max)(m_Nodes[child1].Height, m_Nodes[child2].Height);
+        m_Nodes[child1].Parent = parent;
+        m_Nodes[child2].Parent = parent;
+        return parent;
+    }
+
+    void DynamicBVH::Clear()
+    {
+        m_Nodes.clear();
+        m_Root = NullNode;
+        m_FreeList = NullNode;
+        m_ProxyCount = 0;
+        m_RebuildAreaRatio = 0.0f;
+    }
+
+    float DynamicBVH::GetAreaRatio() const
+    {
+        if (m_Root == NullNode)
+            return 0.0f;
+
+        const float rootArea = m_Nodes[m_Root].Bounds.GetArea();
+        if (rootArea <= 0.0f)
+            return 0.0f;
+
+        float totalArea = 0.0f;
+        for (const Node& node : m_Nodes)
+        {
+            if (node.Height > 0)
+                totalArea += node.Bounds.GetArea();
+        }
+        return totalArea / rootArea;
+    }
+
+    void DynamicBVH::InsertLeaf(int32_t leaf)
+    {
+        if (m_Root == NullNode)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].Parent = NullNode;
+            return;
+        }
+
+        // Walk down to the sibling that grows the summed area the least
+        const AABB leafBounds = m_Nodes[leaf].Bounds;
+        int32_t index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node& node = m_Nodes[index];
+            const float area = node.Bounds.GetArea();
+            const float combinedArea = AABB::Union(node.Bounds, leafBounds).GetArea();
+
+            // Pairing with this node creates a parent over both, descending grows this node either way
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child)
+            {
+                const Node& childNode = m_Nodes[child];
+                const float unionArea = AABB::Union(childNode.Bounds, leafBounds).GetArea();
+                return (childNode.IsLeaf() ? unionArea : unionArea - childNode.Bounds.GetArea()) + inheritanceCost;
+            };
+
+            const float cost1 = descendCost(node.Child1);
+            const float cost2 = descendCost(node.Child2);
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.Child1 : node.Child2;
+        }
+
+        const int32_t sibling = index;
+        const int32_t oldParent = m_Nodes[sibling].Parent;
+        const int32_t newParent = AllocateNode();
+
+        Node& parent = m_Nodes[newParent];
+        parent.Parent = oldParent;
+        parent.Bounds = AABB::Union(leafBounds, m_Nodes[sibling].Bounds);
+        parent.Height = m_Nodes[sibling].Height + 1;
+        parent.Child1 = sibling;
+        parent.Child2 = leaf;
+
+        if (oldParent != NullNode)
+        {
+            if (m_Nodes[oldParent].Child1 == sibling)
+                m_Nodes[oldParent].Child1 = newParent;
+            else
+                m_Nodes[oldParent].Child2 = newParent;
+        }
+        else
+        {
+            m_Root = newParent;
+        }
+
+        m_Nodes[sibling].Parent = newParent;
+        m_Nodes[leaf].Parent = newParent;
+
+        FixUpwards(m_Nodes[leaf].Parent);
+    }
+
+    void DynamicBVH::RemoveLeaf(int32_t leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = NullNode;
+            return;
+        }
+
+        // The sibling takes the place of the parent
+        const int32_t parent = m_Nodes[leaf].Parent;
+        const int32_t grandParent = m_Nodes[parent].Parent;
+        const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+        FreeNode(parent);
+        m_Nodes[sibling].Parent = grandParent;
+        if (grandParent == NullNode)
+        {
+            m_Root = sibling;
+            return;
+        }
+
+        if (m_Nodes[grandParent].Child1 == parent)
+            m_Nodes[grandParent].Child1 = sibling;
+        else
+            m_Nodes[grandParent].Child2 = sibling;
+
+        FixUpwards(grandParent);
+    }
+
+    void DynamicBVH::FixUpwards(int32_t index)
+    {
+        while (index != NullNode)
+        {
+            index = Balance(index);
+
+            Node& node = m_Nodes[index];
+            const Node& child1 = m_Nodes[node.Child1];
+            const Node& child2 = m_Nodes[node.Child2];
+            node.Height = 1 + (std::max)(child1.Height, child2.Height);
+            node.Bounds = AABB::Union(child1.Bounds, child2.Bounds);
+
+            index = node.Parent;
+        }
+    }
+
+    // Rotates the taller child of a up if the children differ in height by more than one, returns the node
+    // that now sits where a was
+    int32_t DynamicBVH::Balance(int32_t iA)
+    {
+        Node& a = m_Nodes[iA];
+        if (a.IsLeaf() || a.Height < 2)
+            return iA;
+
+        const int32_t iB = a.Child1;
+        const int32_t iC = a.Child2;
+        Node& b = m_Nodes[iB];
+        Node& c = m_Nodes[iC];
+
+        auto replaceChild = [this](int32_t parent, int32_t oldChild, int32_t newChild)
+        {
+            if (parent == NullNode)
+                m_Root = newChild;
+            else if (m_Nodes[parent].Child1 == oldChild)
+                m_Nodes[parent].Child1 = newChild;
+            else
+                m_Nodes[parent].Child2 = newChild;
+        };
+
+        const int32_t balance = c.Height - b.Height;
+        if (balance > 1)
+        {
+            // Rotate c up
+            const int32_t iF = c.Child1;
+            const int32_t iG = c.Child2;
+            Node& f = m_Nodes[iF];
+            Node& g = m_Nodes[iG];
+
+            c.Child1 = iA;
+            c.Parent = a.Parent;
+            a.Parent = iC;
+            replaceChild(c.Parent, iA, iC);
+
+            if (f.Height > g.Height)
+            {
+                c.Child2 = iF;
+                a.Child2 = iG;
+                g.Parent = iA;
+                a.Bounds = AABB::Union(b.Bounds, g.Bounds);
+                c.Bounds = AABB::Union(a.Bounds, f.Bounds);
+                a.Height = 1 + (std::max)(b.Height, g.Height);
+                c.Height = 1 + (std::max)(a.Height, f.Height);
+            }
+            else
+            {
+                c.Child2 = iG;
+                a.Child2 = iF;
+                f.Parent = iA;
+                a.Bounds = AABB::Union(b.Bounds, f.Bounds);
+                c.Bounds = AABB::Union(a.Bounds, g.Bounds);
+                a.Height = 1 + (std::max)(b.Height, f.Height);
+                c.Height = 1 + (std::max)(a.Height, g.Height);
+            }
+            return iC;
+        }
+
+        if (balance < -1)
+        {
+            // Rotate b up
+            const int32_t iD = b.Child1;
+            const int32_t iE = b.Child2;
+            Node& d = m_Nodes[iD];
+            Node& e = m_Nodes[iE];
+
+            b.Child1 = iA;
+            b.Parent = a.Parent;
+            a.Parent = iB;
+            replaceChild(b.Parent, iA, iB);
+
+            if (d.Height > e.Height)
+            {
+                b.Child2 = iD;
+                a.Child1 = iE;
+                e.Parent = iA;
+                a.Bounds = AABB::Union(c.Bounds, e.Bounds);
+                b.Bounds = AABB::Union(a.Bounds, d.Bounds);
+                a.Height = 1 + (std::max)(c.Height, e.Height);
+                b.Height = 1 + (std::max)(a.Height, d.Height);
+            }
+            else
+            {
+                b.Child2 = iE;
+                a.Child1 = iD;
+                d.Parent = iA;
+                a.Bounds = AABB::Union(c.Bounds, d.Bounds);
+                b.Bounds = AABB::Union(a.Bounds, e.Bounds);
+                a.Height = 1 + (std::max)(c.Height, d.Height);
+                b.Height = 1 + (std::max)(a.Height, e.Height);
+            }
+            return iB;
+        }
+
+        return iA;
+    }
+
+} // namespace Titan
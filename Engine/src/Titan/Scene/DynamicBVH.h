@@ -0,0 +1,187 @@
+#pragma once
+
+#include <span>
+#include "Titan/PCH.h"
+#include "Titan/Utils/Geometry.h"
+
+namespace Titan
+{
+
+    // Bounding volume hierarchy over moving boxes, in the style of the Box2D dynamic tree. Leaves keep the exact
+    // bounds they were given and a fattened copy, so small movements don't touch the tree. Inserts pick their
+    // sibling by surface area and rotations keep the tree balanced.
+    class TI_API DynamicBVH
+    {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+        struct ProxyMove
+        {
+            int32_t Proxy;
+            AABB Bounds;
+        };
+
+        int32_t CreateProxy(const AABB& bounds, uint32_t userData);
+        void DestroyProxy(int32_t proxy);
+        // Returns true if the proxy left its fattened bounds and was reinserted
+        bool MoveProxy(int32_t proxy, const AABB& bounds);
+        // Moves few proxies one by one. When a large part of the tree moved, every node is refit in one pass
+        // instead and the tree is rebuilt once refitting has degraded it too far.
+        void MoveProxies(std::span<const ProxyMove> moves);
+
+        // Top down rebuild of all internal nodes, proxies stay valid
+        void Rebuild();
+        void Clear();
+
+        uint32_t GetUserData(int32_t proxy) const { return m_Nodes[proxy].UserData; }
+        void SetUserData(int32_t proxy, uint32_t userData) { m_Nodes[proxy].UserData = userData; }
+        const AABB& GetBounds(int32_t proxy) const { return m_Nodes[proxy].Tight; }
+        uint32_t GetProxyCount() const { return m_ProxyCount; }
+        uint32_t GetHeight() const { return m_Root == NullNode ? 0 : (uint32_t)m_Nodes[m_Root].Height; }
+        // Summed area of the internal nodes relative to the root, lower is a tighter tree
+        float GetAreaRatio() const;
+
+        // callback(uint32_t userData) for every proxy whose bounds overlap
+        template <typename Callback>
+        void Query(const AABB& bounds, Callback&& callback) const
+        {
+            Traverse([&](const AABB& node) { return node.Overlaps(bounds); }, callback);
+        }
+
+        template <typename Callback>
+        void QuerySphere(const glm::vec3& center, float radius, Callback&& callback) const
+        {
+            Traverse([&](const AABB& node) { return node.OverlapsSphere(center, radius); }, callback);
+        }
+
+        template <typename Callback>
+        void QueryFrustum(const Frustum& frustum, Callback&& callback) const
+        {
+            Traverse([&](const AABB& node) { return frustum.Overlaps(node); }, callback);
+        }
+
+        // callback(uint32_t userData, float distance) for proxies the ray enters within maxDistance. It returns
+        // the new maximum distance, which clips the rest of the cast, or a negative value to stop.
+        template <typename Callback>
+        void RayCast(const Ray& ray, float maxDistance, Callback&& callback) const
+        {
+            if (m_Root == NullNode)
+                return;
+
+            TraversalStack stack;
+            stack.Push(m_Root);
+            while (!stack.IsEmpty())
+            {
+                const Node& node = m_Nodes[stack.Pop()];
+                const float distance = ray.Intersect(node.IsLeaf() ? node.Tight : node.Bounds, maxDistance);
+                if (distance < 0.0f)
+                    continue;
+
+                if (node.IsLeaf())
+                {
+                    const float clip = callback(node.UserData, distance);
+                    if (clip < 0.0f)
+                        return;
+                    maxDistance = (std::min)(maxDistance, clip);
+                }
+                else
+                {
+                    stack.Push(node.Child1);
+                    stack.Push(node.Child2);
+                }
+            }
+        }
+
+    private:
+        struct Node
+        {
+            AABB Bounds; // Fattened for leaves
+            AABB Tight;  // Leaves only
+            int32_t Parent = NullNode; // Next free node while unused
+            int32_t Child1 = NullNode;
+            int32_t Child2 = NullNode;
+            int32_t Height = -1; // 0 for leaves, -1 while unused
+            uint32_t UserData = 0;
+
+            bool IsLeaf() const { return Child1 == NullNode; }
+        };
+
+        // Traversals rarely go deeper than the fixed part, the vector only takes over for degenerate trees
+        class TraversalStack
+        {
+        public:
+            void Push(int32_t node)
+            {
+                if (m_Size < m_Fixed.size())
+                    m_Fixed[m_Size] = node;
+                else
+                    m_Overflow.push_back(node);
+                m_Size++;
+            }
+
+            int32_t Pop()
+            {
+                m_Size--;
+                if (m_Size < m_Fixed.size())
+                    return m_Fixed[m_Size];
+
+                const int32_t node = m_Overflow.back();
+                m_Overflow.pop_back();
+                return node;
+            }
+
+            bool IsEmpty() const { return m_Size == 0; }
+
+        private:
+            std::array<int32_t, 256> m_Fixed;
+            std::vector<int32_t> m_Overflow;
+            size_t m_Size = 0;
+        };
+
+        template <typename Overlaps, typename Callback>
+        void Traverse(const Overlaps& overlaps, Callback& callback) const
+        {
+            if (m_Root == NullNode)
+                return;
+
+            TraversalStack stack;
+            stack.Push(m_Root);
+            while (!stack.IsEmpty())
+            {
+                const Node& node = m_Nodes[stack.Pop()];
+                if (node.IsLeaf())
+                {
+                    if (overlaps(node.Tight))
+                        callback(node.UserData);
+                }
+                else if (overlaps(node.Bounds))
+                {
+                    stack.Push(node.Child1);
+                    stack.Push(node.Child2);
+                }
+            }
+        }
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t Balance(int32_t node);
+        // Refits bounds and heights from node up to the root, balancing on the way
+        void FixUpwards(int32_t node);
+
+        void Refit(int32_t node);
+        int32_t BuildRange(std::vector<int32_t>& leaves, size_t begin, size_t end);
+
+    private:
+        std::vector<Node> m_Nodes;
+        int32_t m_Root = NullNode;
+        int32_t m_FreeList = NullNode;
+        uint32_t m_ProxyCount = 0;
+
+        // Area ratio right after the last rebuild, refitting rebuilds once the tree is worse than this by some margin
+        float m_RebuildAreaRatio = 0.0f;
+    };
+
+} // namespace Titan
@@ -15,4 +15,8 @@ namespace Titan
     {
         return GetComponent<TagComponent>().Tag;
     }
+    void Entity::SetName(const std::string& name)
+    {
+        m_Scene->SetEntityName(*this, name);
+    }
 } // namespace Titan
\ No newline at end of file
@@ -37,6 +37,14 @@ namespace Titan
             return component;
         }
 
+        // Runs function(T&) and lets the scene know the component changed, for edits it has to react to like a new mesh
+        template <typename T, typename Function>
+        T& PatchComponent(Function&& function)
+        {
+            TI_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+            return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Function>(function));
+        }
+
         template <typename T>
         bool HasComponent()
         {
@@ -51,11 +59,14 @@ namespace Titan
         }
 
         operator bool() const { return m_EntityHandle != entt::null; }
+        // False once the entity was destroyed, also when its index has since been recycled for a new entity
+        bool IsValid() const { return m_Scene && m_Scene->m_Registry.valid(m_EntityHandle); }
         operator entt::entity() const { return m_EntityHandle; }
         operator uint32_t() const { return (uint32_t)m_EntityHandle; }
 
         UUID GetUUID();
         std::string GetName();
+        void SetName(const std::string& name);
 
         bool operator==(const Entity& other) const
         {
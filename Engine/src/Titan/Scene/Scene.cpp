@@ -6,6 +6,8 @@
 #include "Titan/Renderer/RenderCommand.h"
 #include "Titan/Renderer/Renderer2D.h"
 #include "Titan/Scripting/ScriptEngine.h"
+#include "Titan/Utils/Hash.h"
+#include "Titan/Utils/Math.h"
 
 #include "box2d/box2d.h"
 
@@ -28,28 +30,133 @@ namespace Titan
         return b2_staticBody;
     }
 
-    Scene::Scene() {}
+    // Bodies carry their entity as user data, contacts only record the pair
+    class ContactListener2D : public b2ContactListener
+    {
+    public:
+        ContactListener2D(std::vector<Scene::ContactEvent>& events) : m_Events(events) {}
+
+        virtual void BeginContact(b2Contact* contact) override { Record(contact, true); }
+        virtual void EndContact(b2Contact* contact) override { Record(contact, false); }
+
+    private:
+        void Record(b2Contact* contact, bool began)
+        {
+            const auto entityA = (entt::entity)contact->GetFixtureA()->GetBody()->GetUserData().pointer;
+            const auto entityB = (entt::entity)contact->GetFixtureB()->GetBody()->GetUserData().pointer;
+            m_Events.push_back({entityA, entityB, began});
+        }
+
+    private:
+        std::vector<Scene::ContactEvent>& m_Events;
+    };
+
+    template <typename Component>
+    void Scene::TrackPhysicsComponent()
+    {
+        m_Registry.on_construct<Component>().template connect<&Scene::OnPhysicsComponentChanged>(*this);
+        m_Registry.on_update<Component>().template connect<&Scene::OnPhysicsComponentChanged>(*this);
+        m_Registry.on_destroy<Component>().template connect<&Scene::OnPhysicsComponentChanged>(*this);
+    }
+
+    template <typename Component>
+    void Scene::TrackRendererComponent()
+    {
+        m_Registry.on_construct<Component>().template connect<&Scene::OnRendererComponentChanged>(*this);
+        m_Registry.on_update<Component>().template connect<&Scene::OnRendererComponentChanged>(*this);
+        m_Registry.on_destroy<Component>().template connect<&Scene::OnRendererComponentChanged>(*this);
+    }
+
+    template <typename Component>
+    void Scene::UntrackComponent()
+    {
+        m_Registry.on_construct<Component>().disconnect(*this);
+        m_Registry.on_update<Component>().disconnect(*this);
+        m_Registry.on_destroy<Component>().disconnect(*this);
+    }
+
+    void Scene::ConnectComponentListeners()
+    {
+        TrackPhysicsComponent<Rigidbody2DComponent>();
+        m_Registry.on_destroy<Rigidbody2DComponent>().connect<&Scene::OnRigidbodyRemoved>(*this);
+        TrackPhysicsComponent<BoxCollider2DComponent>();
+        TrackPhysicsComponent<CircleCollider2DComponent>();
+        TrackRendererComponent<MeshRendererComponent>();
+        TrackRendererComponent<SpriteRendererComponent>();
+        TrackRendererComponent<CircleRendererComponent>();
+    }
+
+    void Scene::DisconnectComponentListeners()
+    {
+        UntrackComponent<Rigidbody2DComponent>();
+        UntrackComponent<BoxCollider2DComponent>();
+        UntrackComponent<CircleCollider2DComponent>();
+        UntrackComponent<MeshRendererComponent>();
+        UntrackComponent<SpriteRendererComponent>();
+        UntrackComponent<CircleRendererComponent>();
+    }
+
+    Scene::Scene()
+    {
+        // Scripts can touch any component and Mono is attached to the main thread only
+        m_Systems.Add("C# Scripts", [](Scene& scene, Timestep ts) { scene.UpdateScripts(ts); })
+            .Exclusive()
+            .OnMainThread();
+        m_Systems.Add("Native Scripts", [](Scene& scene, Timestep ts) { scene.UpdateNativeScripts(ts); })
+            .Exclusive()
+            .OnMainThread();
+        // Runs OnFixedUpdate scripts between the physics steps, so it has the same constraints as the scripts
+        m_Systems.Add("Fixed Update", [](Scene& scene, Timestep ts) { scene.FixedUpdate(ts, true); })
+            .Exclusive()
+            .OnMainThread();
+        m_Systems.Add("World Transforms", [](Scene& scene, Timestep ts) { scene.UpdateWorldTransforms(); })
+            .Reads<TransformComponent, RelationshipComponent, Rigidbody2DComponent, MeshRendererComponent,
+                   SpriteRendererComponent, CircleRendererComponent>()
+            .Writes<WorldTransformComponent, SpatialIndexResource, PhysicsBodiesResource>();
+
+        ConnectComponentListeners();
+    }
 
     Scene::~Scene()
     {
+        JobSystem::Wait(m_PhysicsCounter);
         delete m_PhysicsWorld;
         m_PhysicsWorld = nullptr;
+        delete m_ContactListener;
+        m_ContactListener = nullptr;
     }
 
+    // Copies a whole pool at once. Copied scenes use the same entity identifiers as their source, so entities
+    // map across without a UUID lookup.
     template <typename Component>
-    static void CopyComponent(entt::registry& dst, entt::registry& src,
-                              const std::unordered_map<UUID, entt::entity>& enttMap)
+    static void CopyStorage(entt::storage_for_t<Component>& dst, const entt::storage_for_t<Component>& src)
     {
-        auto view = src.view<Component>();
-        for (auto e : view)
-        {
-            UUID uuid = src.get<IDComponent>(e).ID;
-            TI_CORE_ASSERT(enttMap.find(uuid) != enttMap.end());
-            entt::entity dstEnttID = enttMap.at(uuid);
+        TI_PROFILE_FUNCTION();
 
-            auto& component = src.get<Component>(e);
-            dst.emplace_or_replace<Component>(dstEnttID, component);
-        }
+        // Sparse set and storage iterate in the same order, entity i owns component i
+        const entt::sparse_set& entities = src;
+        dst.reserve(src.size());
+        dst.insert(entities.begin(), entities.end(), src.begin());
+    }
+
+    // One job per component type, pools are independent of each other
+    template <typename... Component>
+    static void CopyStorages(ComponentGroup<Component...>, entt::registry& dst, entt::registry& src,
+                             JobCounter& counter)
+    {
+        (
+            [&]()
+            {
+                // Pools are created on this thread, the jobs only fill them
+                auto* srcStorage = &src.storage<Component>();
+                auto* dstStorage = &dst.storage<Component>();
+                if (!srcStorage->empty())
+                {
+                    JobSystem::Execute([dstStorage, srcStorage]() { CopyStorage<Component>(*dstStorage, *srcStorage); },
+                                       &counter);
+                }
+            }(),
+            ...);
     }
 
     template <typename Component>
@@ -61,6 +168,8 @@ namespace Titan
 
     Ref<Scene> Scene::Copy(Ref<Scene> other)
     {
+        TI_PROFILE_FUNCTION();
+
         Ref<Scene> newScene = CreateRef<Scene>();
 
         newScene->m_ViewportWidth = other->m_ViewportWidth;
@@ -68,28 +177,20 @@ namespace Titan
 
         auto& srcSceneRegistry = other->m_Registry;
         auto& dstSceneRegistry = newScene->m_Registry;
-        std::unordered_map<UUID, entt::entity> enttMap;
 
-        auto idView = srcSceneRegistry.view<IDComponent>();
-        for (auto e : idView)
-        {
-            UUID uuid = srcSceneRegistry.get<IDComponent>(e).ID;
-            const auto& name = srcSceneRegistry.get<TagComponent>(e).Tag;
-            Entity newEntity = newScene->CreateEntityWithUUID(uuid, name);
-            enttMap[uuid] = (entt::entity)newEntity;
-        }
+        for (auto entity : srcSceneRegistry.view<entt::entity>())
+            dstSceneRegistry.create(entity);
+        newScene->m_EntityMap = other->m_EntityMap;
 
-        CopyComponent<DirectionalLightComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<TransformComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<SpriteRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<CircleRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<MeshRendererComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<CameraComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<NativeScriptComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<Rigidbody2DComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<BoxCollider2DComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<CircleCollider2DComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
-        CopyComponent<ScriptComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
+        // The pools are filled on workers, where the listeners must not run. The new scene has no physics world
+        // yet and builds its spatial index from scratch, so there is nothing they would record.
+        newScene->DisconnectComponentListeners();
+        JobCounter counter;
+        CopyStorages(ComponentGroup<IDComponent, TagComponent, RelationshipComponent, WorldTransformComponent>{},
+                     dstSceneRegistry, srcSceneRegistry, counter);
+        CopyStorages(AllComponents{}, dstSceneRegistry, srcSceneRegistry, counter);
+        JobSystem::Wait(counter);
+        newScene->ConnectComponentListeners();
 
         return newScene;
     }
@@ -104,10 +205,15 @@ namespace Titan
         Entity entity(m_Registry.create(), this);
         entity.AddComponent<IDComponent>(uuid);
         entity.AddComponent<TransformComponent>();
+        entity.AddComponent<RelationshipComponent>();
+        entity.AddComponent<WorldTransformComponent>();
         auto& tag = entity.AddComponent<TagComponent>();
         tag.Tag = name.empty() ? "Entity" : name;
 
         m_EntityMap[uuid] = entity;
+        m_HierarchyDirty = true;
+        if (!m_NameIndexDirty)
+            AddToNameIndex(entity, tag.Tag);
 
         return entity;
     }
@@ -127,12 +233,415 @@ namespace Titan
         CopyComponentIfExists<BoxCollider2DComponent>(newEntity, entity);
         CopyComponentIfExists<CircleCollider2DComponent>(newEntity, entity);
         CopyComponentIfExists<ScriptComponent>(newEntity, entity);
+
+        // The copy is a sibling, the local transform was copied as is so no conversion is needed
+        UUID parent = entity.GetComponent<RelationshipComponent>().Parent;
+        if (parent)
+        {
+            newEntity.GetComponent<RelationshipComponent>().Parent = parent;
+            GetEntityByUUID(parent).GetComponent<RelationshipComponent>().Children.push_back(newEntity.GetUUID());
+        }
     }
 
     void Scene::DestroyEntity(Entity entity)
     {
+        // Contacts of the joined step reach the scripts, which may destroy the entity themselves
+        WaitForPhysics();
+        if (!m_Registry.valid(entity))
+            return;
+
+        // Destroying a child moves other components around in the pool, so nothing is held across the recursion
+        const UUID parentID = entity.GetComponent<RelationshipComponent>().Parent;
+        const std::vector<UUID> children = entity.GetComponent<RelationshipComponent>().Children;
+
+        // Children go with their parent
+        for (UUID child : children)
+        {
+            if (Entity childEntity = GetEntityByUUID(child))
+                DestroyEntity(childEntity);
+        }
+
+        // A child's script may have destroyed this entity already
+        if (!m_Registry.valid(entity))
+            return;
+
+        if (parentID)
+        {
+            if (Entity parent = GetEntityByUUID(parentID))
+                std::erase(parent.GetComponent<RelationshipComponent>().Children, entity.GetUUID());
+        }
+
+        if (!m_NameIndexDirty)
+            RemoveFromNameIndex(entity, entity.GetComponent<TagComponent>().Tag);
+
+        if (m_IsRunning)
+            ScriptEngine::OnDestroyEntity(entity);
+
+        // Otherwise the body keeps colliding, ending its contacts here records their exit events
+        DestroyPhysicsBody(entity);
+
         m_EntityMap.erase(entity.GetUUID());
         m_Registry.destroy(entity);
+        m_HierarchyDirty = true;
+        m_TransformStorageVersion++;
+    }
+
+    bool Scene::IsDescendantOf(Entity entity, Entity ancestor)
+    {
+        UUID ancestorID = ancestor.GetUUID();
+        UUID parent = entity.GetComponent<RelationshipComponent>().Parent;
+        while (parent)
+        {
+            if (parent == ancestorID)
+                return true;
+
+            Entity parentEntity = GetEntityByUUID(parent);
+            if (!parentEntity)
+                return false;
+            parent = parentEntity.GetComponent<RelationshipComponent>().Parent;
+        }
+        return false;
+    }
+
+    void Scene::ParentEntity(Entity entity, Entity parent)
+    {
+        if (!parent)
+        {
+            UnparentEntity(entity);
+            return;
+        }
+
+        if (entity == parent || IsDescendantOf(parent, entity))
+        {
+            TI_CORE_WARN("Cannot parent {} to its own descendant {}", entity.GetName(), parent.GetName());
+            return;
+        }
+
+        UnparentEntity(entity);
+
+        glm::mat4 world = GetWorldTransform(entity);
+        entity.GetComponent<RelationshipComponent>().Parent = parent.GetUUID();
+        parent.GetComponent<RelationshipComponent>().Children.push_back(entity.GetUUID());
+
+        auto& tc = entity.GetComponent<TransformComponent>();
+        Math::DecomposeTransform(glm::inverse(GetWorldTransform(parent)) * world, tc.Translation, tc.Rotation,
+                                 tc.Scale);
+
+        m_HierarchyDirty = true;
+    }
+
+    void Scene::UnparentEntity(Entity entity)
+    {
+        auto& relationship = entity.GetComponent<RelationshipComponent>();
+        if (!relationship.Parent)
+            return;
+
+        glm::mat4 world = GetWorldTransform(entity);
+        if (Entity parent = GetEntityByUUID(relationship.Parent))
+            std::erase(parent.GetComponent<RelationshipComponent>().Children, entity.GetUUID());
+        relationship.Parent = 0;
+
+        auto& tc = entity.GetComponent<TransformComponent>();
+        Math::DecomposeTransform(world, tc.Translation, tc.Rotation, tc.Scale);
+
+        m_HierarchyDirty = true;
+    }
+
+    glm::mat4 Scene::GetWorldTransform(Entity entity)
+    {
+        glm::mat4 transform = entity.GetComponent<TransformComponent>().GetTransform();
+
+        UUID parent = entity.GetComponent<RelationshipComponent>().Parent;
+        while (parent)
+        {
+            Entity parentEntity = GetEntityByUUID(parent);
+            if (!parentEntity)
+                break;
+
+            transform = parentEntity.GetComponent<TransformComponent>().GetTransform() * transform;
+            parent = parentEntity.GetComponent<RelationshipComponent>().Parent;
+        }
+
+        return transform;
+    }
+
+    void Scene::RebuildTransformOrder()
+    {
+        TI_PROFILE_FUNCTION();
+
+        m_TransformOrder.clear();
+        m_TransformOrder.reserve(m_EntityMap.size());
+
+        auto view = m_Registry.view<RelationshipComponent>();
+        for (auto e : view)
+        {
+            // Entities whose parent no longer exists are treated as roots
+            UUID parent = view.get<RelationshipComponent>(e).Parent;
+            if (!parent || m_EntityMap.find(parent) == m_EntityMap.end())
+                m_TransformOrder.push_back({e, NoParent});
+        }
+
+        // Breadth first, appending children while walking the list
+        for (uint32_t i = 0; i < (uint32_t)m_TransformOrder.size(); i++)
+        {
+            const auto& relationship = m_Registry.get<RelationshipComponent>(m_TransformOrder[i].Entity);
+            for (UUID child : relationship.Children)
+            {
+                auto it = m_EntityMap.find(child);
+                if (it != m_EntityMap.end())
+                    m_TransformOrder.push_back({it->second, i});
+            }
+        }
+
+        m_HierarchyDirty = false;
+    }
+
+    // The world matrix with a body's pose swapped in, keeps the scale and the rotation out of the 2D plane
+    static glm::mat4 WithBodyPose(const glm::mat4& world, const glm::vec2& position, float angle)
+    {
+        glm::vec3 translation, rotation, scale;
+        Math::DecomposeTransform(world, translation, rotation, scale);
+        translation.x = position.x;
+        translation.y = position.y;
+        rotation.z = angle;
+
+        return glm::translate(glm::mat4(1.0f), translation) * glm::toMat4(glm::quat(rotation)) *
+               glm::scale(glm::mat4(1.0f), scale);
+    }
+
+    void Scene::UpdateWorldTransforms()
+    {
+        TI_PROFILE_FUNCTION();
+
+        // A rebuilt order has no valid cached transforms yet
+        const bool updateAll = m_HierarchyDirty;
+        if (m_HierarchyDirty)
+            RebuildTransformOrder();
+
+        m_TransformFrame++;
+        const bool trackBodies = m_PhysicsWorld && !m_PhysicsRunning;
+
+        auto transforms = m_Registry.view<TransformComponent>();
+        auto worldTransforms = m_Registry.view<WorldTransformComponent>();
+
+        for (auto& node : m_TransformOrder)
+        {
+            // Bodies that moved in the last step are drawn between it and the one before, so what is shown
+            // trails the simulation by one step
+            const Rigidbody2DComponent* interpolatedBody = nullptr;
+            if (m_PhysicsRunning)
+            {
+                interpolatedBody = m_Registry.try_get<Rigidbody2DComponent>(node.Entity);
+                if (interpolatedBody && interpolatedBody->MovedStep != m_PhysicsStep)
+                    interpolatedBody = nullptr;
+            }
+            const bool parentInterpolated = node.Parent != NoParent && m_TransformOrder[node.Parent].Interpolated;
+
+            // Local changes are detected by comparing against the transform the matrix was built from,
+            // so nothing that writes TransformComponent has to remember to flag it
+            const auto& tc = transforms.get<TransformComponent>(node.Entity);
+            bool dirty = updateAll || tc.Translation != node.Translation || tc.Rotation != node.Rotation ||
+                         tc.Scale != node.Scale || interpolatedBody || node.Interpolated;
+            if (node.Parent != NoParent)
+                dirty |= m_TransformOrder[node.Parent].UpdatedFrame == m_TransformFrame;
+
+            if (!dirty)
+                continue;
+
+            node.UpdatedFrame = m_TransformFrame;
+            node.Translation = tc.Translation;
+            node.Rotation = tc.Rotation;
+            node.Scale = tc.Scale;
+
+            auto& world = worldTransforms.get<WorldTransformComponent>(node.Entity);
+            const glm::mat4 local = tc.GetTransform();
+            const WorldTransformComponent* parentWorld =
+                node.Parent == NoParent
+                    ? nullptr
+                    : &worldTransforms.get<WorldTransformComponent>(m_TransformOrder[node.Parent].Entity);
+            const glm::mat4 matrix = parentWorld ? parentWorld->Matrix * local : local;
+
+            // Edits move bodies in the persistent physics world, while running the bodies move the transforms
+            if (trackBodies && matrix != world.Matrix && m_Registry.all_of<Rigidbody2DComponent>(node.Entity))
+                OnPhysicsComponentChanged(m_Registry, node.Entity);
+            world.Matrix = matrix;
+
+            // Box2D angles are not wrapped, so they interpolate without a seam
+            if (interpolatedBody)
+                world.RenderMatrix = WithBodyPose(
+                    matrix, glm::mix(interpolatedBody->PreviousPosition, interpolatedBody->Position, m_PhysicsAlpha),
+                    glm::mix(interpolatedBody->PreviousAngle, interpolatedBody->Angle, m_PhysicsAlpha));
+            else if (parentInterpolated)
+                world.RenderMatrix = parentWorld->RenderMatrix * local;
+            else
+                world.RenderMatrix = matrix;
+            node.Interpolated = interpolatedBody || parentInterpolated;
+        }
+
+        UpdateSpatialIndex(updateAll);
+    }
+
+    AABB Scene::GetWorldBounds(entt::entity entity, const glm::mat4& worldTransform) const
+    {
+        AABB local;
+        if (auto* mesh = m_Registry.try_get<MeshRendererComponent>(entity); mesh && mesh->MeshRef)
+            local = {mesh->MeshRef->GetBoundsMin(), mesh->MeshRef->GetBoundsMax()};
+        else if (m_Registry.any_of<SpriteRendererComponent, CircleRendererComponent>(entity))
+            local = {glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.5f, 0.5f, 0.0f)};
+
+        return local.Transformed(worldTransform);
+    }
+
+    void Scene::OnRendererComponentChanged(entt::registry& registry, entt::entity entity)
+    {
+        // A changed hierarchy recomputes every bounds anyway, bulk loads and copies skip the list
+        if (!m_HierarchyDirty)
+            m_DirtyBounds.push_back(entity);
+    }
+
+    // Bounds are recomputed for entities whose world transform or renderer changed
+    void Scene::UpdateSpatialIndex(bool hierarchyChanged)
+    {
+        TI_PROFILE_FUNCTION();
+
+        auto worldTransforms = m_Registry.view<WorldTransformComponent>();
+        std::vector<entt::entity> dirtyBounds = std::move(m_DirtyBounds);
+        m_DirtyBounds.clear();
+
+        if (!hierarchyChanged)
+        {
+            std::vector<DynamicBVH::ProxyMove> moves;
+            for (const auto& node : m_TransformOrder)
+            {
+                if (node.UpdatedFrame != m_TransformFrame)
+                    continue;
+
+                const auto& world = worldTransforms.get<WorldTransformComponent>(node.Entity);
+                moves.push_back({m_SpatialProxies[entt::to_entity(node.Entity)],
+                                 GetWorldBounds(node.Entity, world.Matrix)});
+            }
+
+            // A proxy moved twice with the same bounds is left alone the second time
+            for (entt::entity entity : dirtyBounds)
+            {
+                const auto index = entt::to_entity(entity);
+                if (!m_Registry.valid(entity) || index >= m_SpatialProxies.size() ||
+                    m_SpatialProxies[index] == DynamicBVH::NullNode)
+                    continue;
+
+                const auto& world = worldTransforms.get<WorldTransformComponent>(entity);
+                moves.push_back({m_SpatialProxies[index], GetWorldBounds(entity, world.Matrix)});
+            }
+
+            m_SpatialIndex.MoveProxies(moves);
+            return;
+        }
+
+        // Entities came or went, proxies are matched up again by entity index and the leftovers destroyed
+        std::vector<int32_t> previous = std::move(m_SpatialProxies);
+        m_SpatialProxies.clear();
+
+        uint32_t created = 0;
+        for (const auto& node : m_TransformOrder)
+        {
+            const auto index = entt::to_entity(node.Entity);
+            if (index >= m_SpatialProxies.size())
+                m_SpatialProxies.resize(index + 1, DynamicBVH::NullNode);
+
+            const AABB bounds =
+                GetWorldBounds(node.Entity, worldTransforms.get<WorldTransformComponent>(node.Entity).Matrix);
+            if (index < previous.size() && previous[index] != DynamicBVH::NullNode)
+            {
+                const int32_t proxy = previous[index];
+                previous[index] = DynamicBVH::NullNode;
+                m_SpatialIndex.SetUserData(proxy, (uint32_t)node.Entity);
+                m_SpatialIndex.MoveProxy(proxy, bounds);
+                m_SpatialProxies[index] = proxy;
+            }
+            else
+            {
+                m_SpatialProxies[index] = m_SpatialIndex.CreateProxy(bounds, (uint32_t)node.Entity);
+                created++;
+            }
+        }
+
+        for (int32_t proxy : previous)
+        {
+            if (proxy != DynamicBVH::NullNode)
+                m_SpatialIndex.DestroyProxy(proxy);
+        }
+
+        // Scenes that were just loaded insert everything at once, the top down build gives a better tree
+        if (created > m_SpatialIndex.GetProxyCount() / 4)
+            m_SpatialIndex.Rebuild();
+    }
+
+    void Scene::QueryAABB(const AABB& bounds, std::vector<entt::entity>& result) const
+    {
+        m_SpatialIndex.Query(bounds, [&](uint32_t entity) { result.push_back((entt::entity)entity); });
+    }
+
+    void Scene::QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& result) const
+    {
+        m_SpatialIndex.QuerySphere(center, radius, [&](uint32_t entity) { result.push_back((entt::entity)entity); });
+    }
+
+    void Scene::QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& result) const
+    {
+        m_SpatialIndex.QueryFrustum(frustum, [&](uint32_t entity) { result.push_back((entt::entity)entity); });
+    }
+
+    Scene::RaycastHit Scene::CastRay(const Ray& ray, float maxDistance) const
+    {
+        RaycastHit hit;
+        m_SpatialIndex.RayCast(ray, maxDistance,
+                               [&](uint32_t entity, float distance)
+                               {
+                                   if (hit.Entity == entt::null || distance < hit.Distance)
+                                       hit = {(entt::entity)entity, distance};
+                                   return hit.Distance;
+                               });
+        return hit;
+    }
+
+    Entity Scene::Raycast(const Ray& ray, float maxDistance, float* outDistance)
+    {
+        const RaycastHit hit = CastRay(ray, maxDistance);
+        if (hit.Entity == entt::null)
+            return {};
+
+        if (outDistance)
+            *outDistance = hit.Distance;
+        return Entity{hit.Entity, this};
+    }
+
+    void Scene::QueryAABBs(std::span<const AABB> bounds, std::vector<std::vector<entt::entity>>& results) const
+    {
+        TI_PROFILE_FUNCTION();
+
+        results.resize(bounds.size());
+        JobSystem::ParallelFor((uint32_t)bounds.size(), 64,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                   {
+                                       results[i].clear();
+                                       QueryAABB(bounds[i], results[i]);
+                                   }
+                               });
+    }
+
+    void Scene::Raycasts(std::span<const Ray> rays, float maxDistance, std::vector<RaycastHit>& hits) const
+    {
+        TI_PROFILE_FUNCTION();
+
+        hits.resize(rays.size());
+        JobSystem::ParallelFor((uint32_t)rays.size(), 64,
+                               [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                       hits[i] = CastRay(rays[i], maxDistance);
+                               });
     }
 
     void Scene::OnRuntimeStart()
@@ -163,6 +672,7 @@ namespace Titan
         OnPhysics2DStop();
 
         ScriptEngine::OnRuntimeStop();
+        m_Registry.clear<ScriptInstanceComponent>();
     }
 
     void Scene::OnSimulationStart()
@@ -181,81 +691,141 @@ namespace Titan
     {
         TI_PROFILE_FUNCTION()
 
-        // C# SCRIPTS
-        {
-            auto view = GetAllEntitiesWith<ScriptComponent>();
-            for (auto e : view)
-            {
-                Entity entity = {e, this};
-                ScriptEngine::OnUpdateEntity(entity, ts);
-            }
-        }
+        WaitForPhysics();
+        m_Systems.Run(*this, ts);
+    }
 
-        // NATIVE SCRIPTS
-        {
-            GetAllEntitiesWith<NativeScriptComponent>().each(
-                [=](auto entity, auto& nsc)
+    void Scene::OnUpdateSimulation(Timestep ts, EditorCamera& camera)
+    {
+        TI_PROFILE_FUNCTION();
+        RenderCommand::SetClearColor({0.1f, 0.1f, 0.1f, 1.0f});
+        RenderCommand::Clear();
+        RenderCommand::SetLineWidth(2.0f);
+
+        FixedUpdate(ts, false);
+        UpdateWorldTransforms();
+    }
+
+    void Scene::UpdateScripts(Timestep ts)
+    {
+        ScriptEngine::OnUpdateScripts(ts);
+    }
+
+    void Scene::UpdateNativeScripts(Timestep ts)
+    {
+        GetAllEntitiesWith<NativeScriptComponent>().each(
+            [=](auto entity, auto& nsc)
+            {
+                if (!nsc.Instance)
                 {
-                    if (!nsc.Instance)
-                    {
-                        nsc.Instance = nsc.InstantiateScript();
-                        nsc.Instance->m_Entity = Entity{entity, this};
+                    nsc.Instance = nsc.InstantiateScript();
+                    nsc.Instance->m_Entity = Entity{entity, this};
 
-                        nsc.Instance->OnCreate();
-                    }
+                    nsc.Instance->OnCreate();
+                }
 
-                    nsc.Instance->OnUpdate(ts);
-                });
-        }
+                nsc.Instance->OnUpdate(ts);
+            });
+    }
 
-        // PHYSICS
+    void Scene::FixedUpdate(Timestep ts, bool runScripts)
+    {
+        TI_PROFILE_FUNCTION();
+
+        WaitForPhysics();
+
+        m_FixedAccumulator += ts;
+        const uint32_t steps = (std::min)((uint32_t)(m_FixedAccumulator / m_FixedTimestep), m_MaxFixedSteps);
+        for (uint32_t i = 0; i < steps; i++)
         {
-            const int32_t velocityIterations = 6;
-            const int32_t positionIterations = 2;
-            m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
+            if (runScripts)
+            {
+                ScriptEngine::OnFixedUpdateScripts(m_FixedTimestep);
+            }
 
-            auto view = GetAllEntitiesWith<Rigidbody2DComponent>();
-            for (auto e : view)
+            // Scripts before the next step need this one done, only the last step of the frame can overlap
+            if (i + 1 < steps)
             {
-                Entity entity = {e, this};
-                auto& transform = entity.GetComponent<TransformComponent>();
-                auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-                b2Body* body = (b2Body*)rb2d.RuntimeBody;
-                const auto& position = body->GetPosition();
-                transform.Translation.x = position.x;
-                transform.Translation.y = position.y;
-                transform.Rotation.z = body->GetAngle();
+                StepPhysics();
+                ApplyPhysicsStep(runScripts);
+                continue;
             }
+
+            m_PhysicsRunScripts = runScripts;
+            m_PhysicsInFlight = true;
+            JobSystem::Execute([this]() { StepPhysics(); }, &m_PhysicsCounter);
         }
+        m_FixedAccumulator -= steps * m_FixedTimestep;
+
+        // Hit the step cap, drop the backlog so one long frame does not make the next ones long too
+        if (m_FixedAccumulator >= m_FixedTimestep)
+            m_FixedAccumulator = std::fmod(m_FixedAccumulator, m_FixedTimestep);
+
+        // UpdateWorldTransforms draws the bodies this far between the last two applied steps
+        m_PhysicsAlpha = m_FixedAccumulator / m_FixedTimestep;
     }
 
-    void Scene::OnUpdateSimulation(Timestep ts, EditorCamera& camera)
+    void Scene::StepPhysics()
     {
         TI_PROFILE_FUNCTION();
-        RenderCommand::SetClearColor({0.1f, 0.1f, 0.1f, 1.0f});
-        RenderCommand::Clear();
-        RenderCommand::SetLineWidth(2.0f);
 
+        const int32_t velocityIterations = 6;
+        const int32_t positionIterations = 2;
+        m_PhysicsWorld->Step(m_FixedTimestep, velocityIterations, positionIterations);
+
+        // Sleeping bodies keep their pose, so only awake ones are published
+        std::vector<BodyPose>& poses = m_BodyPoses[m_BackPoses];
+        poses.clear();
+        for (b2Body* body = m_PhysicsWorld->GetBodyList(); body; body = body->GetNext())
         {
-            const int32_t velocityIterations = 6;
-            const int32_t positionIterations = 2;
-            m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
+            if (!body->IsAwake())
+                continue;
 
-            auto view = GetAllEntitiesWith<Rigidbody2DComponent>();
-            for (auto e : view)
-            {
-                Entity entity = {e, this};
-                auto& transform = entity.GetComponent<TransformComponent>();
-                auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-                b2Body* body = (b2Body*)rb2d.RuntimeBody;
-                const auto& position = body->GetPosition();
-                transform.Translation.x = position.x;
-                transform.Translation.y = position.y;
-                transform.Rotation.z = body->GetAngle();
-            }
+            const b2Vec2& position = body->GetPosition();
+            poses.push_back({(entt::entity)body->GetUserData().pointer, {position.x, position.y}, body->GetAngle()});
+        }
+    }
+
+    void Scene::ApplyPhysicsStep(bool runScripts)
+    {
+        TI_PROFILE_FUNCTION();
+
+        const std::vector<BodyPose>& poses = m_BodyPoses[m_BackPoses];
+        m_BackPoses ^= 1;
+        m_PhysicsStep++;
+
+        for (const BodyPose& pose : poses)
+        {
+            // The entity or its rigidbody may have been removed since the step published the pose
+            if (!m_Registry.valid(pose.Entity))
+                continue;
+            auto* rb2d = m_Registry.try_get<Rigidbody2DComponent>(pose.Entity);
+            if (!rb2d)
+                continue;
+
+            if (rb2d->MovedStep == 0)
+                m_MovedBodies.push_back({pose.Entity, rb2d->Position, rb2d->Angle});
+            rb2d->PreviousPosition = rb2d->Position;
+            rb2d->PreviousAngle = rb2d->Angle;
+            rb2d->Position = pose.Position;
+            rb2d->Angle = pose.Angle;
+            rb2d->MovedStep = m_PhysicsStep;
+
+            // Scripts and the next step see the simulated pose, the interpolation only exists for rendering
+            WriteBackPhysicsTransform(pose.Entity, pose.Position, pose.Angle);
         }
+
+        DispatchContactEvents(runScripts);
+    }
+
+    void Scene::WaitForPhysics()
+    {
+        if (!m_PhysicsInFlight)
+            return;
+
+        JobSystem::Wait(m_PhysicsCounter);
+        m_PhysicsInFlight = false;
+        ApplyPhysicsStep(m_PhysicsRunScripts);
     }
 
     void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
@@ -264,6 +834,18 @@ namespace Titan
         RenderCommand::SetClearColor({0.1f, 0.1f, 0.1f, 1.0f});
         RenderCommand::Clear();
         RenderCommand::SetLineWidth(2.0f);
+
+        UpdateWorldTransforms();
+    }
+
+    void Scene::SetFixedUpdateRate(float hz)
+    {
+        if (!(hz > 0.0f))
+        {
+            TI_CORE_ERROR("Fixed update rate must be positive, got {}", hz);
+            return;
+        }
+        m_FixedTimestep = 1.0f / hz;
     }
 
     void Scene::OnViewportResize(uint32_t width, uint32_t height)
@@ -283,18 +865,88 @@ namespace Titan
         }
     }
 
-    Entity Scene::FindEntityByName(std::string_view name)
+    void Scene::RebuildNameIndex()
     {
+        TI_PROFILE_FUNCTION();
+
+        m_NameIndex.clear();
         auto view = m_Registry.view<TagComponent>();
         for (auto entity : view)
+            AddToNameIndex(entity, view.get<TagComponent>(entity).Tag);
+
+        m_NameIndexDirty = false;
+    }
+
+    void Scene::AddToNameIndex(entt::entity entity, std::string_view name)
+    {
+        m_NameIndex[Hash::FNV1a(name)].push_back(entity);
+    }
+
+    void Scene::RemoveFromNameIndex(entt::entity entity, std::string_view name)
+    {
+        auto it = m_NameIndex.find(Hash::FNV1a(name));
+        if (it == m_NameIndex.end())
+            return;
+
+        std::vector<entt::entity>& entities = it->second;
+        auto found = std::find(entities.begin(), entities.end(), entity);
+        if (found != entities.end())
+        {
+            *found = entities.back();
+            entities.pop_back();
+        }
+
+        if (entities.empty())
+            m_NameIndex.erase(it);
+    }
+
+    void Scene::SetEntityName(Entity entity, const std::string& name)
+    {
+        auto& tag = entity.GetComponent<TagComponent>();
+        if (tag.Tag == name)
+            return;
+
+        if (!m_NameIndexDirty)
+        {
+            RemoveFromNameIndex(entity, tag.Tag);
+            AddToNameIndex(entity, name);
+        }
+        tag.Tag = name;
+    }
+
+    Entity Scene::FindEntityByName(std::string_view name)
+    {
+        if (m_NameIndexDirty)
+            RebuildNameIndex();
+
+        auto it = m_NameIndex.find(Hash::FNV1a(name));
+        if (it == m_NameIndex.end())
+            return {};
+
+        for (auto entity : it->second)
         {
-            const TagComponent& tc = view.get<TagComponent>(entity);
-            if (tc.Tag == name)
+            if (m_Registry.get<TagComponent>(entity).Tag == name)
                 return Entity{entity, this};
         }
         return {};
     }
 
+    void Scene::FindEntitiesByName(std::string_view name, std::vector<entt::entity>& result)
+    {
+        if (m_NameIndexDirty)
+            RebuildNameIndex();
+
+        auto it = m_NameIndex.find(Hash::FNV1a(name));
+        if (it == m_NameIndex.end())
+            return;
+
+        for (auto entity : it->second)
+        {
+            if (m_Registry.get<TagComponent>(entity).Tag == name)
+                result.push_back(entity);
+        }
+    }
+
     Entity Scene::GetEntityByUUID(UUID uuid)
     {
         if (m_EntityMap.find(uuid) != m_EntityMap.end())
@@ -319,66 +971,320 @@ namespace Titan
     void Scene::OnPhysics2DStart()
     {
         TI_PROFILE_FUNCTION();
-        m_PhysicsWorld = new b2World({0.0f, -9.8f});
+        if (!m_PhysicsWorld)
+            SyncPhysicsBodies();
+
+        m_ContactListener = new ContactListener2D(m_ContactEvents);
+        m_PhysicsWorld->SetContactListener(m_ContactListener);
+        m_PhysicsRunning = true;
+        m_FixedAccumulator = 0.0f;
+        m_PhysicsStep = 0;
+        m_MovedBodies.clear();
+
+        // Contacts still touching from the last session never begin again, a fresh world reports them in its
+        // first step
+        for (b2Contact* contact = m_PhysicsWorld->GetContactList(); contact; contact = contact->GetNext())
+        {
+            if (contact->IsTouching())
+                m_ContactListener->BeginContact(contact);
+        }
 
         auto view = m_Registry.view<Rigidbody2DComponent>();
         for (auto e : view)
         {
-            Entity entity = {e, this};
-            auto& transform = entity.GetComponent<TransformComponent>();
-            auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+            auto& rb2d = view.get<Rigidbody2DComponent>(e);
+            b2Body* body = GetPhysicsBody(e);
+            rb2d.RuntimeBody = body;
+            if (!body)
+                continue;
+
+            rb2d.Position = {body->GetPosition().x, body->GetPosition().y};
+            rb2d.Angle = body->GetAngle();
+            rb2d.PreviousPosition = rb2d.Position;
+            rb2d.PreviousAngle = rb2d.Angle;
+            rb2d.MovedStep = 0;
+        }
+    }
 
-            b2BodyDef bodyDef;
-            bodyDef.type = Rigidbody2DTypeToBox2DBody(rb2d.Type);
-            bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
-            bodyDef.angle = transform.Rotation.z;
+    void Scene::OnPhysics2DStop()
+    {
+        TI_PROFILE_FUNCTION();
+        WaitForPhysics();
 
-            b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
-            body->SetFixedRotation(rb2d.FixedRotation);
-            rb2d.RuntimeBody = body;
+        Ref<Scene> source = m_PhysicsSource.lock();
+        if (m_PhysicsWorld && source)
+        {
+            RewindPhysicsBodies();
 
-            if (entity.HasComponent<BoxCollider2DComponent>())
+            // Entities this session destroyed or changed still exist unchanged in the source, so it rebuilds them
+            for (entt::entity e : m_DirtyBodies)
             {
-                auto& bc2d = entity.GetComponent<BoxCollider2DComponent>();
-                auto mat = bc2d.Material;
-
-                b2PolygonShape boxShape;
-                boxShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y);
-
-                b2FixtureDef fixtureDef;
-                fixtureDef.shape = &boxShape;
-                fixtureDef.density = mat->Density;
-                fixtureDef.friction = mat->Friction;
-                fixtureDef.restitution = mat->Restitution;
-                fixtureDef.restitutionThreshold = mat->RestitutionThreshold;
-                body->CreateFixture(&fixtureDef);
+                if (auto* rb2d = source->m_Registry.try_get<Rigidbody2DComponent>(e))
+                    rb2d->RuntimeBody = nullptr;
+                source->m_DirtyBodies.push_back(e);
             }
+            m_DirtyBodies.clear();
+
+            source->m_PhysicsWorld = m_PhysicsWorld;
+            source->m_PhysicsBodies = std::move(m_PhysicsBodies);
+        }
+        else
+        {
+            delete m_PhysicsWorld;
+        }
+
+        m_PhysicsWorld = nullptr;
+        m_PhysicsBodies.clear();
+        m_DirtyBodies.clear();
+        m_PhysicsSource.reset();
+        m_PhysicsRunning = false;
+        m_MovedBodies.clear();
+        delete m_ContactListener;
+        m_ContactListener = nullptr;
+        m_ContactEvents.clear();
+    }
+
+    void Scene::BorrowPhysicsWorld(const Ref<Scene>& source)
+    {
+        TI_PROFILE_FUNCTION();
+        TI_CORE_ASSERT(!m_PhysicsWorld, "Scene already has a physics world");
+
+        // The copy was taken before the sync, only the rebuilt bodies need their pointers refreshed
+        std::vector<entt::entity> synced = source->SyncPhysicsBodies();
+        m_PhysicsWorld = source->m_PhysicsWorld;
+        m_PhysicsBodies = std::move(source->m_PhysicsBodies);
+        m_PhysicsSource = source;
+        source->m_PhysicsWorld = nullptr;
+        source->m_PhysicsBodies.clear();
+
+        for (entt::entity e : synced)
+        {
+            if (auto* rb2d = m_Registry.try_get<Rigidbody2DComponent>(e))
+                rb2d->RuntimeBody = GetPhysicsBody(e);
+        }
+    }
 
-            if (entity.HasComponent<CircleCollider2DComponent>())
+    void Scene::MarkPhysicsDirty(Entity entity)
+    {
+        OnPhysicsComponentChanged(m_Registry, entity);
+    }
+
+    void Scene::OnPhysicsComponentChanged(entt::registry& registry, entt::entity entity)
+    {
+        // Without a world there is nothing to keep current, the first sync builds every body
+        if (!m_PhysicsWorld)
+            return;
+
+        const auto index = entt::to_entity(entity);
+        if (index >= m_PhysicsBodies.size())
+            m_PhysicsBodies.resize(index + 1);
+
+        if (m_PhysicsBodies[index].Dirty)
+            return;
+
+        m_PhysicsBodies[index].Dirty = true;
+        m_DirtyBodies.push_back(entity);
+    }
+
+    void Scene::OnRigidbodyRemoved(entt::registry& registry, entt::entity entity)
+    {
+        // Bodies are only synced when a session starts, one removed while running would keep simulating
+        if (m_PhysicsRunning)
+            DestroyPhysicsBody(entity);
+    }
+
+    std::vector<entt::entity> Scene::SyncPhysicsBodies()
+    {
+        TI_PROFILE_FUNCTION();
+
+        UpdateWorldTransforms();
+
+        if (!m_PhysicsWorld)
+        {
+            m_PhysicsWorld = new b2World({0.0f, -9.8f});
+            m_PhysicsBodies.clear();
+            m_DirtyBodies.clear();
+            for (auto e : m_Registry.view<Rigidbody2DComponent>())
+                OnPhysicsComponentChanged(m_Registry, e);
+        }
+
+        std::vector<entt::entity> dirty = std::move(m_DirtyBodies);
+        m_DirtyBodies.clear();
+
+        // Destroying everything first frees the slots of destroyed entities whose index was reused since
+        for (entt::entity e : dirty)
+            DestroyPhysicsBody(e);
+
+        for (entt::entity e : dirty)
+        {
+            m_PhysicsBodies[entt::to_entity(e)].Dirty = false;
+            if (m_Registry.valid(e) && m_Registry.all_of<Rigidbody2DComponent>(e) && !GetPhysicsBody(e))
+                CreatePhysicsBody({e, this});
+        }
+
+        return dirty;
+    }
+
+    void Scene::CreatePhysicsBody(Entity entity)
+    {
+        auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+
+        // World space pose, only children need the cached world matrix decomposed
+        TransformComponent transform = entity.GetComponent<TransformComponent>();
+        if (entity.GetComponent<RelationshipComponent>().Parent)
+            Math::DecomposeTransform(entity.GetComponent<WorldTransformComponent>().Matrix, transform.Translation,
+                                     transform.Rotation, transform.Scale);
+
+        b2BodyDef bodyDef;
+        bodyDef.type = Rigidbody2DTypeToBox2DBody(rb2d.Type);
+        bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
+        bodyDef.angle = transform.Rotation.z;
+        bodyDef.userData.pointer = (uintptr_t)(entt::entity)entity;
+
+        b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
+        body->SetFixedRotation(rb2d.FixedRotation);
+        rb2d.RuntimeBody = body;
+        m_PhysicsBodies[entt::to_entity(entity)].Body = body;
+
+        if (entity.HasComponent<BoxCollider2DComponent>())
+        {
+            auto& bc2d = entity.GetComponent<BoxCollider2DComponent>();
+            auto mat = bc2d.Material;
+
+            b2PolygonShape boxShape;
+            boxShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y);
+
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = &boxShape;
+            fixtureDef.density = mat->Density;
+            fixtureDef.friction = mat->Friction;
+            fixtureDef.restitution = mat->Restitution;
+            fixtureDef.restitutionThreshold = mat->RestitutionThreshold;
+            body->CreateFixture(&fixtureDef);
+        }
+
+        if (entity.HasComponent<CircleCollider2DComponent>())
+        {
+            auto& cc2d = entity.GetComponent<CircleCollider2DComponent>();
+            auto mat = cc2d.Material;
+
+            b2CircleShape circleShape;
+            circleShape.m_p.Set(cc2d.Offset.x, cc2d.Offset.y);
+            circleShape.m_radius = transform.Scale.x * cc2d.Radius;
+
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = &circleShape;
+            fixtureDef.density = mat->Density;
+            fixtureDef.friction = mat->Friction;
+            fixtureDef.restitution = mat->Restitution;
+            fixtureDef.restitutionThreshold = mat->RestitutionThreshold;
+            body->CreateFixture(&fixtureDef);
+        }
+    }
+
+    void Scene::DestroyPhysicsBody(entt::entity entity)
+    {
+        b2Body* body = GetPhysicsBody(entity);
+        if (!body)
+            return;
+
+        // The editor can get here while the last step of the frame still runs on a worker. Its poses are applied
+        // as usual by the next WaitForPhysics.
+        JobSystem::Wait(m_PhysicsCounter);
+        m_PhysicsWorld->DestroyBody(body);
+        m_PhysicsBodies[entt::to_entity(entity)].Body = nullptr;
+        if (auto* rb2d = m_Registry.try_get<Rigidbody2DComponent>(entity))
+            rb2d->RuntimeBody = nullptr;
+
+        // A play session destroying the entity hands this on, the scene the world returns to rebuilds it
+        OnPhysicsComponentChanged(m_Registry, entity);
+    }
+
+    b2Body* Scene::GetPhysicsBody(entt::entity entity) const
+    {
+        const auto index = entt::to_entity(entity);
+        return index < m_PhysicsBodies.size() ? m_PhysicsBodies[index].Body : nullptr;
+    }
+
+    void Scene::RewindPhysicsBodies()
+    {
+        TI_PROFILE_FUNCTION();
+
+        // Bodies that never woke up are still where the session found them
+        m_PhysicsWorld->SetContactListener(nullptr);
+        for (const BodyPose& start : m_MovedBodies)
+        {
+            b2Body* body = GetPhysicsBody(start.Entity);
+            if (!body)
+                continue;
+
+            // Disabling drops the body's contacts, the next session finds them again from its start pose
+            body->SetEnabled(false);
+            body->SetTransform({start.Position.x, start.Position.y}, start.Angle);
+            body->SetLinearVelocity({0.0f, 0.0f});
+            body->SetAngularVelocity(0.0f);
+            body->SetEnabled(true);
+            body->SetAwake(true);
+        }
+        m_MovedBodies.clear();
+    }
+
+    void Scene::DispatchContactEvents(bool runScripts)
+    {
+        if (m_ContactEvents.empty())
+            return;
+
+        if (runScripts)
+        {
+            TI_PROFILE_FUNCTION();
+
+            // Native scripts may destroy entities, later events can refer to them
+            auto notify = [this](entt::entity self, entt::entity other, bool began)
             {
-                auto& cc2d = entity.GetComponent<CircleCollider2DComponent>();
-                auto mat = cc2d.Material;
-
-                b2CircleShape circleShape;
-                circleShape.m_p.Set(cc2d.Offset.x, cc2d.Offset.y);
-                circleShape.m_radius = transform.Scale.x * cc2d.Radius;
-
-                b2FixtureDef fixtureDef;
-                fixtureDef.shape = &circleShape;
-                fixtureDef.density = mat->Density;
-                fixtureDef.friction = mat->Friction;
-                fixtureDef.restitution = mat->Restitution;
-                fixtureDef.restitutionThreshold = mat->RestitutionThreshold;
-                body->CreateFixture(&fixtureDef);
+                if (!m_Registry.valid(self) || !m_Registry.valid(other))
+                    return;
+
+                auto* nsc = m_Registry.try_get<NativeScriptComponent>(self);
+                if (!nsc || !nsc->Instance)
+                    return;
+
+                if (began)
+                    nsc->Instance->OnCollisionEnter({other, this});
+                else
+                    nsc->Instance->OnCollisionExit({other, this});
+            };
+
+            for (const ContactEvent& event : m_ContactEvents)
+            {
+                notify(event.EntityA, event.EntityB, event.Began);
+                notify(event.EntityB, event.EntityA, event.Began);
             }
+
+            std::erase_if(m_ContactEvents, [this](const ContactEvent& event)
+                          { return !m_Registry.valid(event.EntityA) || !m_Registry.valid(event.EntityB); });
+            ScriptEngine::OnContactEvents(m_ContactEvents);
         }
+
+        m_ContactEvents.clear();
     }
 
-    void Scene::OnPhysics2DStop()
+    void Scene::WriteBackPhysicsTransform(entt::entity entity, const glm::vec2& position, float angle)
     {
-        TI_PROFILE_FUNCTION();
-        delete m_PhysicsWorld;
-        m_PhysicsWorld = nullptr;
+        auto& transform = m_Registry.get<TransformComponent>(entity);
+        UUID parent = m_Registry.get<RelationshipComponent>(entity).Parent;
+        if (!parent)
+        {
+            transform.Translation.x = position.x;
+            transform.Translation.y = position.y;
+            transform.Rotation.z = angle;
+            return;
+        }
+
+        // Bring the world space pose back into the parent's space
+        const glm::mat4 world = WithBodyPose(GetWorldTransform({entity, this}), position, angle);
+        const glm::mat4 parentWorld = GetWorldTransform(GetEntityByUUID(parent));
+        Math::DecomposeTransform(glm::inverse(parentWorld) * world, transform.Translation, transform.Rotation,
+                                 transform.Scale);
     }
 
     template <typename T>
@@ -395,6 +1301,8 @@ namespace Titan
     template void Scene::OnComponentAdded<IDComponent>(Entity, IDComponent&);
     template void Scene::OnComponentAdded<TagComponent>(Entity, TagComponent&);
     template void Scene::OnComponentAdded<TransformComponent>(Entity, TransformComponent&);
+    template void Scene::OnComponentAdded<RelationshipComponent>(Entity, RelationshipComponent&);
+    template void Scene::OnComponentAdded<WorldTransformComponent>(Entity, WorldTransformComponent&);
     template void Scene::OnComponentAdded<SpriteRendererComponent>(Entity, SpriteRendererComponent&);
     template void Scene::OnComponentAdded<CircleRendererComponent>(Entity, CircleRendererComponent&);
     template void Scene::OnComponentAdded<MeshRendererComponent>(Entity, MeshRendererComponent&);
@@ -405,4 +1313,5 @@ namespace Titan
     template void Scene::OnComponentAdded<BoxCollider2DComponent>(Entity, BoxCollider2DComponent&);
     template void Scene::OnComponentAdded<CircleCollider2DComponent>(Entity, CircleCollider2DComponent&);
     template void Scene::OnComponentAdded<ScriptComponent>(Entity, ScriptComponent&);
+    template void Scene::OnComponentAdded<ScriptInstanceComponent>(Entity, ScriptInstanceComponent&);
 } // namespace Titan
\ No newline at end of file
@@ -1,16 +1,21 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include "DynamicBVH.h"
+#include "SystemScheduler.h"
+#include "Titan/Core/JobSystem.h"
 #include "Titan/Core/Timestep.h"
 #include "Titan/Core/UUID.h"
 #include "Titan/PCH.h"
 #include "Titan/Renderer/EditorCamera.h"
 
 class b2World;
+class b2Body;
 
 namespace Titan
 {
     class Entity;
+    class ContactListener2D;
 
     class TI_API Scene
     {
@@ -30,6 +35,13 @@ namespace Titan
         void OnSimulationStart();
         void OnSimulationStop();
 
+        // The physics world outlives play sessions. It is built on the first play and then kept current by
+        // rebuilding only the bodies of entities whose rigidbody, colliders or transform changed. A copy made for
+        // play borrows the world of its source, the stop rewinds the bodies that moved and hands it back.
+        void BorrowPhysicsWorld(const Ref<Scene>& source);
+        // For edits made in place on a physics component, which the registry can't see
+        void MarkPhysicsDirty(Entity entity);
+
         void OnUpdateRuntime(Timestep ts);
         void OnUpdateSimulation(Timestep ts, EditorCamera& camera);
         void OnUpdateEditor(Timestep ts, EditorCamera& camera);
@@ -37,24 +49,148 @@ namespace Titan
 
         void DuplicateEntity(Entity entity);
 
+        // Both keep the entity where it is in world space
+        void ParentEntity(Entity entity, Entity parent);
+        void UnparentEntity(Entity entity);
+
+        // Recomputes the cached WorldTransformComponent of every entity whose local transform or ancestor changed
+        void UpdateWorldTransforms();
+        // Walks up the hierarchy, always current even between UpdateWorldTransforms calls
+        glm::mat4 GetWorldTransform(Entity entity);
+
+        // Spatial queries against the world bounds of renderables, and a point at the origin of every other entity.
+        // They see the scene as of the last UpdateWorldTransforms. Results are appended.
+        void QueryAABB(const AABB& bounds, std::vector<entt::entity>& result) const;
+        void QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& result) const;
+        void QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& result) const;
+        // Closest entity whose bounds the ray enters, invalid on a miss
+        Entity Raycast(const Ray& ray, float maxDistance, float* outDistance = nullptr);
+
+        struct RaycastHit
+        {
+            entt::entity Entity = entt::null;
+            float Distance = 0.0f;
+        };
+
+        // Batched queries, spread over the job system. Results line up with the inputs.
+        void QueryAABBs(std::span<const AABB> bounds, std::vector<std::vector<entt::entity>>& results) const;
+        void Raycasts(std::span<const Ray> rays, float maxDistance, std::vector<RaycastHit>& hits) const;
+
+        // Name lookups go through an index from name hashes to entities, kept current by CreateEntity,
+        // DestroyEntity and SetEntityName
         Entity FindEntityByName(std::string_view name);
+        // Every entity with the given name, appended to result
+        void FindEntitiesByName(std::string_view name, std::vector<entt::entity>& result);
+        void SetEntityName(Entity entity, const std::string& name);
         Entity GetEntityByUUID(UUID uuid);
         Entity GetPrimaryCameraEntity();
 
         bool IsRunning() const { return m_IsRunning; }
 
+        // Scripts hold pointers into the transform pool. Pool pages never move, but destroying an entity fills its
+        // slot with the last transform, so this counter is bumped and scripts fetch their pointer again.
+        const uint32_t* GetTransformStorageVersion() const { return &m_TransformStorageVersion; }
+
+        // Physics and OnFixedUpdate scripts run at a fixed rate, rendering interpolates between the last two steps
+        void SetFixedUpdateRate(float hz);
+        float GetFixedTimestep() const { return m_FixedTimestep; }
+        // Caps the fixed steps taken in one frame, time beyond that is dropped instead of catching up
+        void SetMaxFixedSteps(uint32_t steps) { m_MaxFixedSteps = steps; }
+
+        // Two colliders started or stopped touching. Recorded while the physics world steps and handed to the
+        // scripts of both entities once the step is done, so no script runs inside the solver.
+        struct ContactEvent
+        {
+            entt::entity EntityA;
+            entt::entity EntityB;
+            bool Began;
+        };
+
         template <typename... Components>
         auto GetAllEntitiesWith()
         {
             return m_Registry.view<Components...>();
         }
 
+        // Scene state outside the registry, declared with Reads and Writes like components
+        struct SpatialIndexResource {};  // behind the spatial queries and Raycast, rebuilt by World Transforms
+        struct NameIndexResource {};     // FindEntityByName and FindEntitiesByName may rebuild it, both write it
+        struct PhysicsBodiesResource {}; // bodies to resync, marked when physics components or transforms change
+
+        // Runtime systems, run by OnUpdateRuntime. Declare the components the update reads and writes
+        // on the returned system so it can run next to the others. Scene queries count as access too: the spatial
+        // queries and Raycast read SpatialIndexResource, so they wait for the World Transforms system, and name
+        // lookups write NameIndexResource. Patching a rigidbody or collider writes PhysicsBodiesResource.
+        SceneSystem& AddSystem(const std::string& name, SceneSystem::UpdateFunction update)
+        {
+            return m_Systems.Add(name, std::move(update));
+        }
+        const std::vector<Scope<SceneSystem>>& GetSystems() const { return m_Systems.GetSystems(); }
+
+        // Splits a view into batches on the job system, function(entt::entity, Components&...).
+        // For use inside systems that declared the access, the function must not add or remove components.
+        template <typename... Components, typename Function>
+        void ParallelEach(Function function, uint32_t batchSize = 256)
+        {
+            auto view = m_Registry.view<Components...>();
+            std::vector<entt::entity> entities(view.begin(), view.end());
+            JobSystem::ParallelFor((uint32_t)entities.size(), batchSize,
+                                   [&](uint32_t begin, uint32_t end)
+                                   {
+                                       for (uint32_t i = begin; i < end; i++)
+                                           function(entities[i], view.template get<Components>(entities[i])...);
+                                   });
+        }
+
     private:
         template <typename T>
         void OnComponentAdded(Entity entity, T& component);
 
         void OnPhysics2DStart();
         void OnPhysics2DStop();
+        // Creates the world if there is none and rebuilds the dirty bodies, returns the entities it processed
+        std::vector<entt::entity> SyncPhysicsBodies();
+        void CreatePhysicsBody(Entity entity);
+        void DestroyPhysicsBody(entt::entity entity);
+        b2Body* GetPhysicsBody(entt::entity entity) const;
+        // Puts the bodies that moved during the session back where they started, with no contacts or velocity
+        void RewindPhysicsBodies();
+        void OnPhysicsComponentChanged(entt::registry& registry, entt::entity entity);
+        void OnRigidbodyRemoved(entt::registry& registry, entt::entity entity);
+        template <typename Component>
+        void TrackPhysicsComponent();
+        void OnRendererComponentChanged(entt::registry& registry, entt::entity entity);
+        template <typename Component>
+        void TrackRendererComponent();
+        template <typename Component>
+        void UntrackComponent();
+        // Registry listeners of the scene, Copy drops them while it fills the pools on workers
+        void ConnectComponentListeners();
+        void DisconnectComponentListeners();
+        // Puts a body's simulated pose into its transform, the body pose is in world space
+        void WriteBackPhysicsTransform(entt::entity entity, const glm::vec2& position, float angle);
+        void DispatchContactEvents(bool runScripts);
+
+        // Steps the world and publishes the poses of awake bodies into the back buffer, runs on any thread
+        void StepPhysics();
+        // Main thread, takes the published poses over into the rigidbodies and passes on the contacts
+        void ApplyPhysicsStep(bool runScripts);
+        // Joins a step still running on a worker. Called before anything else touches the physics world.
+        void WaitForPhysics();
+
+        void UpdateScripts(Timestep ts);
+        void UpdateNativeScripts(Timestep ts);
+        void FixedUpdate(Timestep ts, bool runScripts);
+
+        void RebuildTransformOrder();
+        void UpdateSpatialIndex(bool hierarchyChanged);
+
+        void RebuildNameIndex();
+        void AddToNameIndex(entt::entity entity, std::string_view name);
+        void RemoveFromNameIndex(entt::entity entity, std::string_view name);
+        AABB GetWorldBounds(entt::entity entity, const glm::mat4& worldTransform) const;
+        RaycastHit CastRay(const Ray& ray, float maxDistance) const;
+        bool IsDescendantOf(Entity entity, Entity ancestor);
 
     private:
         entt::registry m_Registry;
@@ -62,9 +198,73 @@ namespace Titan
         bool m_IsRunning = false;
 
         b2World* m_PhysicsWorld = nullptr;
+        ContactListener2D* m_ContactListener = nullptr;
+        std::vector<ContactEvent> m_ContactEvents;
+
+        // Indexed by entity, without version. A body is rebuilt at most once per sync however often it changed.
+        struct PhysicsBodySlot
+        {
+            b2Body* Body = nullptr;
+            bool Dirty = false;
+        };
+        std::vector<PhysicsBodySlot> m_PhysicsBodies;
+        std::vector<entt::entity> m_DirtyBodies;
+        std::weak_ptr<Scene> m_PhysicsSource; // Scene the world was borrowed from
+        bool m_PhysicsRunning = false;
+
+        // The last fixed step of a frame runs on a worker while the frame finishes and renders, the next frame
+        // joins it before its scripts run
+        struct BodyPose
+        {
+            entt::entity Entity;
+            glm::vec2 Position;
+            float Angle;
+        };
+        std::array<std::vector<BodyPose>, 2> m_BodyPoses;
+        uint32_t m_BackPoses = 0; // Written by the step, the other buffer holds the poses applied last
+        uint32_t m_PhysicsStep = 0;
+        // Pose at the start of the session of every body that has moved since, the stop rewinds only these
+        std::vector<BodyPose> m_MovedBodies;
+        JobCounter m_PhysicsCounter;
+        bool m_PhysicsInFlight = false;
+        bool m_PhysicsRunScripts = false;
+        float m_FixedTimestep = 1.0f / 60.0f;
+        uint32_t m_MaxFixedSteps = 4;
+        float m_FixedAccumulator = 0.0f;
+        float m_PhysicsAlpha = 0.0f; // How far the frame is between the last applied step and the next
 
         std::unordered_map<UUID, entt::entity> m_EntityMap;
 
+        SystemScheduler m_Systems;
+
+        // Entities in breadth first hierarchy order, so parents always come before their children.
+        // The local transform is the one the cached world matrix was last built from.
+        struct TransformNode
+        {
+            entt::entity Entity;
+            uint32_t Parent;       // Index into m_TransformOrder, NoParent for roots
+            uint32_t UpdatedFrame; // Children of a node updated this frame are dirty too
+            glm::vec3 Translation, Rotation, Scale;
+            bool Interpolated = false; // The render matrix differs from the world matrix
+        };
+        static constexpr uint32_t NoParent = UINT32_MAX;
+
+        std::vector<TransformNode> m_TransformOrder;
+        uint32_t m_TransformFrame = 0;
+        bool m_HierarchyDirty = true;
+        uint32_t m_TransformStorageVersion = 0;
+
+        // Proxies follow the transform updates. Indexed by entity, without version.
+        DynamicBVH m_SpatialIndex;
+        std::vector<int32_t> m_SpatialProxies;
+        // Renderers added, changed or removed since the last update, their bounds changed without a move
+        std::vector<entt::entity> m_DirtyBounds;
+
+        // Entities by the hash of their name, lookups compare the names to tell collisions apart.
+        // Bulk loads and copies leave it dirty and the next lookup rebuilds it.
+        std::unordered_map<uint64_t, std::vector<entt::entity>> m_NameIndex;
+        bool m_NameIndexDirty = true;
+
         friend class Entity;
         friend class SceneSerializer;
         friend class SceneHierarchyPanel;
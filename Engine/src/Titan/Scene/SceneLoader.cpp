@@ -0,0 +1,214 @@
+#include "SceneLoader.h"
+#include "Assets.h"
+#include "Titan/PCH.h"
+#include "Titan/Renderer/RendererAPI.h"
+
+namespace Titan
+{
+
+    SceneLoader::SceneLoader(const std::filesystem::path& path)
+        : m_Path(path), m_Runtime(SceneSerializer::IsRuntimeScene(path)),
+          m_LoadRenderAssets(RendererAPI::GetAPI() != RendererAPI::API::None), m_Scene(CreateRef<Scene>())
+    {
+        JobSystem::Execute([this]() { Parse(); }, &m_ParseCounter);
+    }
+
+    SceneLoader::~SceneLoader()
+    {
+        // The jobs write into this object
+        JobSystem::Wait(m_ParseCounter);
+        JobSystem::Wait(m_DecodeCounter);
+    }
+
+    void SceneLoader::Parse()
+    {
+        TI_PROFILE_FUNCTION();
+
+        if (m_Runtime)
+        {
+            m_ParseFailed = !SceneSerializer::CollectRuntimeAssetPaths(m_Path.string(), m_AssetPaths);
+            return;
+        }
+
+        try
+        {
+            const YAML::Node document = YAML::LoadFile(m_Path.string());
+            if (document["Entities"])
+                m_Entities = document["Entities"];
+        }
+        catch (const YAML::Exception&)
+        {
+            m_ParseFailed = true;
+            return;
+        }
+
+        SceneSerializer::CollectAssetPaths(m_Entities, m_AssetPaths);
+    }
+
+    void SceneLoader::StartDecoding()
+    {
+        TI_PROFILE_FUNCTION();
+
+        auto removeDuplicates = [](std::vector<std::string>& paths)
+        {
+            std::sort(paths.begin(), paths.end());
+            paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+        };
+        removeDuplicates(m_AssetPaths.Textures);
+        removeDuplicates(m_AssetPaths.Meshes);
+
+        // Assets already in the library are picked up by the deserializer as they are
+        for (const std::string& path : m_AssetPaths.Textures)
+        {
+            if (!AssetLibrary::Exists(path))
+                m_Textures.push_back({path, {}});
+        }
+        for (const std::string& path : m_AssetPaths.Meshes)
+        {
+            if (!AssetLibrary::Exists(path))
+                m_Meshes.push_back({path, nullptr});
+        }
+
+        // Both vectors have their final size here, every job writes only its own element
+        for (size_t i = 0; i < m_Textures.size(); i++)
+        {
+            JobSystem::Execute([this, i]() { m_Textures[i].Image = TextureImage::Decode(m_Textures[i].Path); },
+                               &m_DecodeCounter);
+        }
+        for (size_t i = 0; i < m_Meshes.size(); i++)
+        {
+            JobSystem::Execute([this, i]() { m_Meshes[i].MeshRef = Mesh::Create(m_Meshes[i].Path); },
+                               &m_DecodeCounter);
+        }
+    }
+
+    bool SceneLoader::Update(float budgetMillis)
+    {
+        TI_PROFILE_FUNCTION();
+
+        Timer timer;
+
+        if (m_Stage == Stage::Parsing)
+        {
+            if (!m_ParseCounter.IsDone())
+                return false;
+
+            if (m_ParseFailed)
+            {
+                TI_CORE_WARN("Could not load scene {}", m_Path.string());
+                m_Stage = Stage::Failed;
+                return true;
+            }
+
+            if (!m_Runtime)
+            {
+                m_EntityCount = m_Entities.size();
+                m_NextEntity = std::as_const(m_Entities).begin();
+            }
+
+            if (m_LoadRenderAssets)
+                StartDecoding();
+
+            m_Stage = Stage::DecodingAssets;
+        }
+
+        if (m_Stage == Stage::DecodingAssets)
+        {
+            if (!m_DecodeCounter.IsDone())
+                return false;
+
+            m_Stage = Stage::CreatingAssets;
+        }
+
+        if (m_Stage == Stage::CreatingAssets)
+        {
+            if (!CreateAssets(timer, budgetMillis))
+                return false;
+
+            m_Stage = Stage::CreatingEntities;
+        }
+
+        if (m_Stage == Stage::CreatingEntities)
+        {
+            if (!CreateEntities(timer, budgetMillis))
+                return false;
+
+            if (m_Stage == Stage::Failed)
+                return true;
+
+            m_Stage = Stage::Done;
+            TI_CORE_INFO("Loaded scene {} in the background ({} assets, {:.2f}ms)", m_Path.string(),
+                         m_Textures.size() + m_Meshes.size(), m_LoadTimer.ElapsedMillis());
+        }
+
+        return true;
+    }
+
+    // Each call makes progress on at least one asset, so a tiny budget still finishes
+    bool SceneLoader::CreateAssets(const Timer& timer, float budgetMillis)
+    {
+        const size_t assetCount = m_Textures.size() + m_Meshes.size();
+        while (m_CreatedAssets < assetCount)
+        {
+            const size_t index = m_CreatedAssets++;
+            if (index < m_Textures.size())
+            {
+                // GPU upload, the one part of a texture that has to happen on the main thread
+                PendingTexture& texture = m_Textures[index];
+                if (texture.Image.IsValid())
+                    Assets::LoadFromImage(texture.Path, texture.Image);
+                texture.Image = {};
+            }
+            else
+            {
+                PendingMesh& mesh = m_Meshes[index - m_Textures.size()];
+                Assets::Add(mesh.Path, mesh.MeshRef);
+                mesh.MeshRef = nullptr;
+            }
+
+            if (timer.ElapsedMillis() >= budgetMillis)
+                return m_CreatedAssets == assetCount;
+        }
+
+        return true;
+    }
+
+    bool SceneLoader::CreateEntities(const Timer& timer, float budgetMillis)
+    {
+        SceneSerializer serializer(m_Scene);
+
+        // A binary scene is inserted in bulk, splitting it would cost more than it saves
+        if (m_Runtime)
+        {
+            if (!serializer.DeserializeRuntime(m_Path.string()))
+                m_Stage = Stage::Failed;
+
+            m_CreatedEntities = m_EntityCount;
+            return true;
+        }
+
+        const YAML::const_iterator end = std::as_const(m_Entities).end();
+        while (m_NextEntity != end)
+        {
+            serializer.DeserializeEntity(*m_NextEntity, m_LoadRenderAssets);
+            ++m_NextEntity;
+            m_CreatedEntities++;
+
+            if (timer.ElapsedMillis() >= budgetMillis)
+                return m_NextEntity == end;
+        }
+
+        return true;
+    }
+
+    float SceneLoader::GetProgress() const
+    {
+        if (IsDone())
+            return 1.0f;
+
+        const size_t total = 1 + m_Textures.size() + m_Meshes.size() + m_EntityCount;
+        const size_t done = (m_Stage == Stage::Parsing ? 0 : 1) + m_CreatedAssets + m_CreatedEntities;
+        return (float)done / (float)total;
+    }
+
+} // namespace Titan
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+#include "Scene.h"
+#include "SceneSerializer.h"
+#include "Titan/Core/JobSystem.h"
+#include "Titan/Core/Timer.h"
+#include "Titan/PCH.h"
+#include "Titan/Renderer/Mesh.h"
+#include "Titan/Renderer/Texture.h"
+
+namespace Titan
+{
+
+    // Loads a scene file without stalling the main thread. The file is parsed and the textures and meshes it
+    // references are decoded on the job system, Update then turns the results into assets and entities a time slice
+    // at a time. The scene is built separately from any active scene and only handed out once it is complete.
+    class TI_API SceneLoader
+    {
+    public:
+        SceneLoader(const std::filesystem::path& path);
+        ~SceneLoader();
+
+        SceneLoader(const SceneLoader&) = delete;
+        SceneLoader& operator=(const SceneLoader&) = delete;
+
+        // Does main thread work until budgetMillis are spent, returns true once loading finished or failed
+        bool Update(float budgetMillis);
+
+        bool IsDone() const { return m_Stage == Stage::Done; }
+        bool HasFailed() const { return m_Stage == Stage::Failed; }
+        // 0 to 1, parsing, every asset and every entity count as one step each
+        float GetProgress() const;
+
+        const std::filesystem::path& GetPath() const { return m_Path; }
+        // Null until the scene is complete
+        Ref<Scene> GetScene() const { return IsDone() ? m_Scene : nullptr; }
+
+    private:
+        enum class Stage
+        {
+            Parsing,
+            DecodingAssets,
+            CreatingAssets,
+            CreatingEntities,
+            Done,
+            Failed
+        };
+
+        struct PendingTexture
+        {
+            std::string Path;
+            TextureImage Image;
+        };
+
+        struct PendingMesh
+        {
+            std::string Path;
+            Ref<Mesh> MeshRef;
+        };
+
+        void Parse();
+        void StartDecoding();
+        bool CreateAssets(const Timer& timer, float budgetMillis);
+        bool CreateEntities(const Timer& timer, float budgetMillis);
+
+    private:
+        std::filesystem::path m_Path;
+        bool m_Runtime = false;
+        bool m_LoadRenderAssets = true;
+        Ref<Scene> m_Scene;
+        Stage m_Stage = Stage::Parsing;
+
+        // Filled by the jobs, only touched on the main thread once their counter is done
+        JobCounter m_ParseCounter;
+        JobCounter m_DecodeCounter;
+        bool m_ParseFailed = false;
+        YAML::Node m_Entities;
+        SceneAssetPaths m_AssetPaths;
+        std::vector<PendingTexture> m_Textures;
+        std::vector<PendingMesh> m_Meshes;
+
+        size_t m_CreatedAssets = 0;
+        size_t m_CreatedEntities = 0;
+        size_t m_EntityCount = 1; // A binary scene is created in one step
+        YAML::const_iterator m_NextEntity;
+
+        Timer m_LoadTimer;
+    };
+
+} // namespace Titan
@@ -3,9 +3,11 @@
 #include "Assets.h"
 #include "Components.h"
 #include "Entity.h"
+#include "Titan/Core/Timer.h"
 #include "Titan/Core/UUID.h"
 #include "Titan/PCH.h"
 #include "Titan/Renderer/Renderer2D.h"
+#include "Titan/Renderer/RendererAPI.h"
 #include "Titan/Scripting/ScriptEngine.h"
 
 namespace YAML
@@ -200,6 +202,24 @@ namespace Titan
             out << YAML::EndMap; // TransformComponent
         }
 
+        if (entity.HasComponent<RelationshipComponent>())
+        {
+            auto& rc = entity.GetComponent<RelationshipComponent>();
+            if (rc.Parent || !rc.Children.empty())
+            {
+                out << YAML::Key << "RelationshipComponent";
+                out << YAML::BeginMap; // RelationshipComponent
+
+                out << YAML::Key << "Parent" << YAML::Value << (uint64_t)rc.Parent;
+                out << YAML::Key << "Children" << YAML::Value << YAML::BeginSeq;
+                for (UUID child : rc.Children)
+                    out << (uint64_t)child;
+                out << YAML::EndSeq;
+
+                out << YAML::EndMap; // RelationshipComponent
+            }
+        }
+
         if (entity.HasComponent<CameraComponent>())
         {
             out << YAML::Key << "CameraComponent";
@@ -400,6 +420,7 @@ namespace Titan
     {
         TI_CORE_ASSERT(!filepath.empty(), "SceneSerializer::Serialize - Filepath is empty!");
         TI_CORE_ASSERT(m_Scene, "SceneSerializer::Serialize - Scene is null!");
+        Timer timer;
         YAML::Emitter out;
         out << YAML::BeginMap;
         out << YAML::Key << "Scene" << YAML::Value << "Untitled";
@@ -419,238 +440,274 @@ namespace Titan
         std::ofstream fout(filepath);
         TI_CORE_ASSERT(fout.is_open(), "SceneSerializer::Serialize - Failed to open file: {}", filepath);
         fout << out.c_str();
-        TI_CORE_INFO("Saved scene to {}", filepath);
+        TI_CORE_INFO("Saved scene to {} ({:.2f}ms)", filepath, timer.ElapsedMillis());
     }
 
-    void SceneSerializer::SerializeRuntime(const std::string& filepath)
+    void SceneSerializer::DeserializeEntity(const YAML::Node& entity, bool loadRenderAssets)
     {
-        // Not implemented
-        TI_CORE_ASSERT(false);
-    }
+        uint64_t uuid = entity["Entity"].as<uint64_t>();
 
-    bool SceneSerializer::Deserialize(const std::string& filepath)
-    {
-        YAML::Node data;
-        try
+        std::string name;
+        auto tagComponent = entity["TagComponent"];
+        if (tagComponent)
+            name = tagComponent["Tag"].as<std::string>();
+
+        TI_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
+
+        Entity deserializedEntity = m_Scene->CreateEntityWithUUID(uuid, name);
+
+        auto transformComponent = entity["TransformComponent"];
+        if (transformComponent)
         {
-            data = YAML::LoadFile(filepath);
+            // Entities always have transforms
+            auto& tc = deserializedEntity.GetComponent<TransformComponent>();
+            tc.Translation = transformComponent["Translation"].as<glm::vec3>();
+            tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
+            tc.Scale = transformComponent["Scale"].as<glm::vec3>();
         }
-        catch (YAML::ParserException e)
+
+        auto relationshipComponent = entity["RelationshipComponent"];
+        if (relationshipComponent)
         {
-            return false;
+            // Entities always have relationships
+            auto& rc = deserializedEntity.GetComponent<RelationshipComponent>();
+            rc.Parent = relationshipComponent["Parent"].as<uint64_t>();
+            for (auto child : relationshipComponent["Children"])
+                rc.Children.push_back(child.as<uint64_t>());
         }
 
-        std::string sceneName = data["Scene"].as<std::string>();
-        TI_CORE_TRACE("Deserializing scene '{0}'", sceneName);
-
-        auto entities = data["Entities"];
-        if (entities)
+        auto cameraComponent = entity["CameraComponent"];
+        if (cameraComponent)
         {
-            for (auto entity : entities)
-            {
-                uint64_t uuid = entity["Entity"].as<uint64_t>();
+            auto& cc = deserializedEntity.AddComponent<CameraComponent>();
 
-                std::string name;
-                auto tagComponent = entity["TagComponent"];
-                if (tagComponent)
-                    name = tagComponent["Tag"].as<std::string>();
+            auto cameraProps = cameraComponent["Camera"];
+            cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
 
-                TI_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
+            cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
+            cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
+            cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
 
-                Entity deserializedEntity = m_Scene->CreateEntityWithUUID(uuid, name);
+            cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+            cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
+            cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
 
-                auto transformComponent = entity["TransformComponent"];
-                if (transformComponent)
-                {
-                    // Entities always have transforms
-                    auto& tc = deserializedEntity.GetComponent<TransformComponent>();
-                    tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-                    tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-                    tc.Scale = transformComponent["Scale"].as<glm::vec3>();
-                }
+            cc.Primary = cameraComponent["Primary"].as<bool>();
+            cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+        }
 
-                auto cameraComponent = entity["CameraComponent"];
-                if (cameraComponent)
-                {
-                    auto& cc = deserializedEntity.AddComponent<CameraComponent>();
+        auto spriteRendererComponent = entity["SpriteRendererComponent"];
+        if (spriteRendererComponent)
+        {
+            auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
+            src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
+            if (spriteRendererComponent["Texture"] && loadRenderAssets)
+            {
+                src.Tex = Assets::Load<Texture2D>(spriteRendererComponent["Texture"].as<std::string>());
+            }
+        }
 
-                    auto cameraProps = cameraComponent["Camera"];
-                    cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
+        auto meshRendererComponent = entity["MeshRendererComponent"];
+        if (meshRendererComponent)
+        {
+            auto& mrc = deserializedEntity.AddComponent<MeshRendererComponent>();
+            if (meshRendererComponent["Mesh"] && loadRenderAssets)
+            {
+                std::string path = meshRendererComponent["Mesh"].as<std::string>();
+                if (path == "quad")
+                    mrc.MeshRef = Mesh::CreateQuad();
+                else if (path == "cube")
+                    mrc.MeshRef = Mesh::CreateCube();
+                else
+                    mrc.MeshRef = Assets::Load<Mesh>(path);
+            }
+            auto materials = mrc.MeshRef ? meshRendererComponent["Materials"] : YAML::Node();
+            int matIndex = 0;
+            for (auto material : materials)
+            {
+                auto mat = mrc.MeshRef->GetMaterial(matIndex);
+                mat->AlbedoColor = material["AlbedoColor"].as<glm::vec4>();
 
-                    cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
-                    cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
-                    cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
+                if (material["AlbedoTexture"])
+                    mat->AlbedoTexture = Assets::Load<Texture2D>(material["AlbedoTexture"].as<std::string>());
 
-                    cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-                    cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
-                    cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
+                if (material["MetallicTexture"])
+                    mat->MetallicTexture =
+                        Assets::Load<Texture2D>(material["MetallicTexture"].as<std::string>());
 
-                    cc.Primary = cameraComponent["Primary"].as<bool>();
-                    cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
-                }
+                if (material["RoughnessTexture"])
+                    mat->RoughnessTexture =
+                        Assets::Load<Texture2D>(material["RoughnessTexture"].as<std::string>());
 
-                auto spriteRendererComponent = entity["SpriteRendererComponent"];
-                if (spriteRendererComponent)
-                {
-                    auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
-                    src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
-                    if (spriteRendererComponent["Texture"])
-                    {
-                        src.Tex = Assets::Load<Texture2D>(spriteRendererComponent["Texture"].as<std::string>());
-                    }
-                }
+                if (material["NormalTexture"])
+                    mat->NormalTexture = Assets::Load<Texture2D>(material["NormalTexture"].as<std::string>());
 
-                auto meshRendererComponent = entity["MeshRendererComponent"];
-                if (meshRendererComponent)
-                {
-                    auto& mrc = deserializedEntity.AddComponent<MeshRendererComponent>();
-                    if (meshRendererComponent["Mesh"])
-                    {
-                        std::string path = meshRendererComponent["Mesh"].as<std::string>();
-                        if (path == "quad")
-                            mrc.MeshRef = Mesh::CreateQuad();
-                        else if (path == "cube")
-                            mrc.MeshRef = Mesh::CreateCube();
-                        else
-                            mrc.MeshRef = Assets::Load<Mesh>(path);
-                    }
-                    auto materials = meshRendererComponent["Materials"];
-                    int matIndex = 0;
-                    for (auto material : materials)
-                    {
-                        auto mat = mrc.MeshRef->GetMaterial(matIndex);
-                        mat->AlbedoColor = material["AlbedoColor"].as<glm::vec4>();
+                if (material["AOTexture"])
+                    mat->AOTexture = Assets::Load<Texture2D>(material["AOTexture"].as<std::string>());
+
+                if (material["UVRepeat"])
+                    mat->UVRepeat = material["UVRepeat"].as<glm::vec2>();
 
-                        if (material["AlbedoTexture"])
-                            mat->AlbedoTexture = Assets::Load<Texture2D>(material["AlbedoTexture"].as<std::string>());
+                matIndex++;
+            }
+        }
 
-                        if (material["MetallicTexture"])
-                            mat->MetallicTexture =
-                                Assets::Load<Texture2D>(material["MetallicTexture"].as<std::string>());
+        auto directionalLightComponent = entity["DirectionalLightComponent"];
+        if (directionalLightComponent)
+        {
+            auto& dlc = deserializedEntity.AddComponent<DirectionalLightComponent>();
+            dlc.Direction = directionalLightComponent["Direction"].as<glm::vec3>();
+        }
 
-                        if (material["RoughnessTexture"])
-                            mat->RoughnessTexture =
-                                Assets::Load<Texture2D>(material["RoughnessTexture"].as<std::string>());
+        auto circleRendererComponent = entity["CircleRendererComponent"];
+        if (circleRendererComponent)
+        {
+            auto& crc = deserializedEntity.AddComponent<CircleRendererComponent>();
+            crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
+            crc.Thickness = circleRendererComponent["Thickness"].as<float>();
+            crc.Fade = circleRendererComponent["Fade"].as<float>();
+        }
 
-                        if (material["NormalTexture"])
-                            mat->NormalTexture = Assets::Load<Texture2D>(material["NormalTexture"].as<std::string>());
+        auto rigidbody2DComponent = entity["Rigidbody2DComponent"];
+        if (rigidbody2DComponent)
+        {
+            auto& rb2d = deserializedEntity.AddComponent<Rigidbody2DComponent>();
+            rb2d.Type = RigidBody2DBodyTypeFromString(rigidbody2DComponent["BodyType"].as<std::string>());
+            rb2d.FixedRotation = rigidbody2DComponent["FixedRotation"].as<bool>();
+        }
 
-                        if (material["AOTexture"])
-                            mat->AOTexture = Assets::Load<Texture2D>(material["AOTexture"].as<std::string>());
+        auto boxCollider2DComponent = entity["BoxCollider2DComponent"];
+        if (boxCollider2DComponent)
+        {
+            auto& bc2d = deserializedEntity.AddComponent<BoxCollider2DComponent>();
+            bc2d.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
+            bc2d.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
+            bc2d.Material =
+                Assets::Load<Physics2DMaterial>(boxCollider2DComponent["Material"].as<std::string>());
+        }
 
-                        if (material["UVRepeat"])
-                            mat->UVRepeat = material["UVRepeat"].as<glm::vec2>();
+        auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
+        if (circleCollider2DComponent)
+        {
+            auto& cc2d = deserializedEntity.AddComponent<CircleCollider2DComponent>();
+            cc2d.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
+            cc2d.Radius = circleCollider2DComponent["Radius"].as<float>();
+            cc2d.Material =
+                Assets::Load<Physics2DMaterial>(circleCollider2DComponent["Material"].as<std::string>());
+        }
 
-                        matIndex++;
-                    }
-                }
+        auto scriptComponent = entity["ScriptComponent"];
+        if (scriptComponent)
+        {
+            auto& sc = deserializedEntity.AddComponent<ScriptComponent>();
+            sc.ClassName = scriptComponent["ClassName"].as<std::string>();
 
-                auto directionalLightComponent = entity["DirectionalLightComponent"];
-                if (directionalLightComponent)
-                {
-                    auto& dlc = deserializedEntity.AddComponent<DirectionalLightComponent>();
-                    dlc.Direction = directionalLightComponent["Direction"].as<glm::vec3>();
-                }
+            auto scriptFields = scriptComponent["ScriptFields"];
+            if (scriptFields)
+            {
+                Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
+                TI_CORE_ASSERT(entityClass);
+                const auto& fields = entityClass->GetFields();
+                auto& entityFields = ScriptEngine::GetScriptFieldMap(deserializedEntity);
 
-                auto circleRendererComponent = entity["CircleRendererComponent"];
-                if (circleRendererComponent)
+                for (auto scriptField : scriptFields)
                 {
-                    auto& crc = deserializedEntity.AddComponent<CircleRendererComponent>();
-                    crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
-                    crc.Thickness = circleRendererComponent["Thickness"].as<float>();
-                    crc.Fade = circleRendererComponent["Fade"].as<float>();
-                }
+                    std::string name = scriptField["Name"].as<std::string>();
+                    std::string typeString = scriptField["Type"].as<std::string>();
+                    ScriptFieldType type = Utils::ScriptFieldTypeFromString(typeString);
 
-                auto rigidbody2DComponent = entity["Rigidbody2DComponent"];
-                if (rigidbody2DComponent)
-                {
-                    auto& rb2d = deserializedEntity.AddComponent<Rigidbody2DComponent>();
-                    rb2d.Type = RigidBody2DBodyTypeFromString(rigidbody2DComponent["BodyType"].as<std::string>());
-                    rb2d.FixedRotation = rigidbody2DComponent["FixedRotation"].as<bool>();
-                }
+                    ScriptFieldInstance& fieldInstance = entityFields[name];
 
-                auto boxCollider2DComponent = entity["BoxCollider2DComponent"];
-                if (boxCollider2DComponent)
-                {
-                    auto& bc2d = deserializedEntity.AddComponent<BoxCollider2DComponent>();
-                    bc2d.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
-                    bc2d.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
-                    bc2d.Material =
-                        Assets::Load<Physics2DMaterial>(boxCollider2DComponent["Material"].as<std::string>());
-                }
+                    TI_CORE_ASSERT(fields.find(name) != fields.end());
 
-                auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
-                if (circleCollider2DComponent)
-                {
-                    auto& cc2d = deserializedEntity.AddComponent<CircleCollider2DComponent>();
-                    cc2d.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
-                    cc2d.Radius = circleCollider2DComponent["Radius"].as<float>();
-                    cc2d.Material =
-                        Assets::Load<Physics2DMaterial>(circleCollider2DComponent["Material"].as<std::string>());
-                }
+                    if (fields.find(name) == fields.end())
+                        continue;
 
-                auto scriptComponent = entity["ScriptComponent"];
-                if (scriptComponent)
-                {
-                    auto& sc = deserializedEntity.AddComponent<ScriptComponent>();
-                    sc.ClassName = scriptComponent["ClassName"].as<std::string>();
+                    fieldInstance.Field = fields.at(name);
 
-                    auto scriptFields = scriptComponent["ScriptFields"];
-                    if (scriptFields)
+                    switch (type)
                     {
-                        Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
-                        TI_CORE_ASSERT(entityClass);
-                        const auto& fields = entityClass->GetFields();
-                        auto& entityFields = ScriptEngine::GetScriptFieldMap(deserializedEntity);
-
-                        for (auto scriptField : scriptFields)
-                        {
-                            std::string name = scriptField["Name"].as<std::string>();
-                            std::string typeString = scriptField["Type"].as<std::string>();
-                            ScriptFieldType type = Utils::ScriptFieldTypeFromString(typeString);
-
-                            ScriptFieldInstance& fieldInstance = entityFields[name];
-
-                            TI_CORE_ASSERT(fields.find(name) != fields.end());
-
-                            if (fields.find(name) == fields.end())
-                                continue;
-
-                            fieldInstance.Field = fields.at(name);
-
-                            switch (type)
-                            {
-                                READ_SCRIPT_FIELD(Float, float);
-                                READ_SCRIPT_FIELD(Double, double);
-                                READ_SCRIPT_FIELD(Bool, bool);
-                                READ_SCRIPT_FIELD(Char, char);
-                                READ_SCRIPT_FIELD(Byte, int8_t);
-                                READ_SCRIPT_FIELD(Short, int16_t);
-                                READ_SCRIPT_FIELD(Int, int32_t);
-                                READ_SCRIPT_FIELD(Long, int64_t);
-                                READ_SCRIPT_FIELD(UByte, uint8_t);
-                                READ_SCRIPT_FIELD(UShort, uint16_t);
-                                READ_SCRIPT_FIELD(UInt, uint32_t);
-                                READ_SCRIPT_FIELD(ULong, uint64_t);
-                                READ_SCRIPT_FIELD(Vector2, glm::vec2);
-                                READ_SCRIPT_FIELD(Vector3, glm::vec3);
-                                READ_SCRIPT_FIELD(Vector4, glm::vec4);
-                                READ_SCRIPT_FIELD(Entity, UUID);
-                            }
-                        }
+                        READ_SCRIPT_FIELD(Float, float);
+                        READ_SCRIPT_FIELD(Double, double);
+                        READ_SCRIPT_FIELD(Bool, bool);
+                        READ_SCRIPT_FIELD(Char, char);
+                        READ_SCRIPT_FIELD(Byte, int8_t);
+                        READ_SCRIPT_FIELD(Short, int16_t);
+                        READ_SCRIPT_FIELD(Int, int32_t);
+                        READ_SCRIPT_FIELD(Long, int64_t);
+                        READ_SCRIPT_FIELD(UByte, uint8_t);
+                        READ_SCRIPT_FIELD(UShort, uint16_t);
+                        READ_SCRIPT_FIELD(UInt, uint32_t);
+                        READ_SCRIPT_FIELD(ULong, uint64_t);
+                        READ_SCRIPT_FIELD(Vector2, glm::vec2);
+                        READ_SCRIPT_FIELD(Vector3, glm::vec3);
+                        READ_SCRIPT_FIELD(Vector4, glm::vec4);
+                        READ_SCRIPT_FIELD(Entity, UUID);
                     }
                 }
             }
         }
+    }
 
-        return true;
+    void SceneSerializer::CollectAssetPaths(const YAML::Node& entities, SceneAssetPaths& paths)
+    {
+        static constexpr const char* s_MaterialTextures[] = {"AlbedoTexture", "MetallicTexture", "RoughnessTexture",
+                                                             "NormalTexture", "AOTexture"};
+
+        for (const auto& entity : entities)
+        {
+            auto spriteRendererComponent = entity["SpriteRendererComponent"];
+            if (spriteRendererComponent && spriteRendererComponent["Texture"])
+                paths.Textures.push_back(spriteRendererComponent["Texture"].as<std::string>());
+
+            auto meshRendererComponent = entity["MeshRendererComponent"];
+            if (!meshRendererComponent || !meshRendererComponent["Mesh"])
+                continue;
+
+            std::string mesh = meshRendererComponent["Mesh"].as<std::string>();
+            if (mesh != "quad" && mesh != "cube")
+                paths.Meshes.push_back(mesh);
+
+            for (const auto& material : meshRendererComponent["Materials"])
+            {
+                for (const char* texture : s_MaterialTextures)
+                {
+                    if (material[texture])
+                        paths.Textures.push_back(material[texture].as<std::string>());
+                }
+            }
+        }
     }
 
-    bool SceneSerializer::DeserializeRuntime(const std::string& filepath)
+    bool SceneSerializer::Deserialize(const std::string& filepath)
     {
-        // Not implemented
-        TI_CORE_ASSERT(false);
-        return false;
+        Timer timer;
+        YAML::Node data;
+        try
+        {
+            data = YAML::LoadFile(filepath);
+        }
+        catch (YAML::ParserException e)
+        {
+            return false;
+        }
+
+        std::string sceneName = data["Scene"].as<std::string>();
+        TI_CORE_TRACE("Deserializing scene '{0}'", sceneName);
+
+        // Headless runs have no graphics context, render components are kept without their GPU assets
+        const bool loadRenderAssets = RendererAPI::GetAPI() != RendererAPI::API::None;
+
+        auto entities = data["Entities"];
+        if (entities)
+        {
+            for (auto entity : entities)
+                DeserializeEntity(entity, loadRenderAssets);
+        }
+
+        TI_CORE_INFO("Loaded scene {} ({} entities, {:.2f}ms)", filepath, entities ? entities.size() : 0,
+                     timer.ElapsedMillis());
+        return true;
     }
 
 } // namespace Titan
\ No newline at end of file
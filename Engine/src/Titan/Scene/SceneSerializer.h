@@ -3,9 +3,23 @@
 #include "Scene.h"
 #include "Titan/PCH.h"
 
+namespace YAML
+{
+    class Node;
+}
+
 namespace Titan
 {
 
+    // Texture and mesh files a scene file references
+    struct SceneAssetPaths
+    {
+        std::vector<std::string> Textures;
+        std::vector<std::string> Meshes;
+    };
+
+    // Serialize writes the YAML scene used for editing and interchange, SerializeRuntime the binary .titanbin
+    // scene that loads through a memory mapping
     class TI_API SceneSerializer
     {
     public:
@@ -17,8 +31,19 @@ namespace Titan
         bool Deserialize(const std::string& filepath);
         bool DeserializeRuntime(const std::string& filepath);
 
+        static bool IsRuntimeScene(const std::filesystem::path& filepath);
+
+    private:
+        void DeserializeEntity(const YAML::Node& entity, bool loadRenderAssets);
+
+        // Read only passes over a parsed YAML scene and a binary scene file, safe on any thread
+        static void CollectAssetPaths(const YAML::Node& entities, SceneAssetPaths& paths);
+        static bool CollectRuntimeAssetPaths(const std::string& filepath, SceneAssetPaths& paths);
+
     private:
         Ref<Scene> m_Scene;
+
+        friend class SceneLoader;
     };
 
 } // namespace Titan
\ No newline at end of file
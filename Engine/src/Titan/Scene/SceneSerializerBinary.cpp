@@ -0,0 +1,901 @@
+#include <span>
+#include "Assets.h"
+#include "Components.h"
+#include "Entity.h"
+#include "SceneSerializer.h"
+#include "Titan/Core/Timer.h"
+#include "Titan/PCH.h"
+#include "Titan/Renderer/RendererAPI.h"
+#include "Titan/Scripting/ScriptEngine.h"
+#include "Titan/Utils/FileSystem.h"
+
+// The runtime scene format: the same data as the YAML scene, laid out as flat record arrays so a load is a memory
+// map, a few range checks and one bulk insert per component type.
+namespace Titan
+{
+    // Bump whenever a record below changes
+    static constexpr uint32_t s_BinarySceneVersion = 1;
+    static constexpr char s_BinarySceneMagic[4] = {'T', 'S', 'C', 'N'};
+    static constexpr uint64_t s_BlockAlignment = 16;
+    static constexpr uint32_t s_NoString = UINT32_MAX;
+
+    enum class SceneBlock : uint32_t
+    {
+        Strings = 0,       // StringRecord
+        StringData,        // char
+        Entities,          // EntityRecord
+        Transforms,        // TransformRecord
+        Relationships,     // RelationshipRecord
+        Children,          // uint64_t UUIDs, ranges referenced by RelationshipRecord
+        Cameras,           // CameraRecord
+        SpriteRenderers,   // SpriteRendererRecord
+        CircleRenderers,   // CircleRendererRecord
+        MeshRenderers,     // MeshRendererRecord
+        Materials,         // MaterialRecord, ranges referenced by MeshRendererRecord
+        DirectionalLights, // DirectionalLightRecord
+        Rigidbodies2D,     // Rigidbody2DRecord
+        BoxColliders2D,    // BoxCollider2DRecord
+        CircleColliders2D, // CircleCollider2DRecord
+        Scripts,           // ScriptRecord
+        ScriptFields,      // ScriptFieldRecord, ranges referenced by ScriptRecord
+        Count
+    };
+
+    struct BinarySceneHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t EntityCount;
+        uint32_t BlockCount; // BlockEntry table follows the header
+    };
+
+    struct BlockEntry
+    {
+        uint32_t Type;
+        uint32_t Count;
+        uint64_t Offset; // From the start of the file
+        uint64_t Size;
+    };
+
+    // Strings are stored once and referenced by index, s_NoString marks a missing one
+    struct StringRecord
+    {
+        uint32_t Offset; // Into the StringData block
+        uint32_t Length;
+    };
+
+    // Component records refer to their entity by its index in the Entities block
+    struct EntityRecord
+    {
+        uint64_t ID;
+        uint32_t Tag;
+        uint32_t Padding;
+    };
+
+    struct TransformRecord
+    {
+        uint32_t Entity;
+        glm::vec3 Translation;
+        glm::vec3 Rotation;
+        glm::vec3 Scale;
+    };
+
+    struct RelationshipRecord
+    {
+        uint32_t Entity;
+        uint32_t FirstChild;
+        uint32_t ChildCount;
+        uint32_t Padding;
+        uint64_t Parent;
+    };
+
+    struct CameraRecord
+    {
+        uint32_t Entity;
+        int32_t ProjectionType;
+        float PerspectiveFOV;
+        float PerspectiveNear;
+        float PerspectiveFar;
+        float OrthographicSize;
+        float OrthographicNear;
+        float OrthographicFar;
+        uint8_t Primary;
+        uint8_t FixedAspectRatio;
+        uint8_t Padding[2];
+    };
+
+    struct SpriteRendererRecord
+    {
+        uint32_t Entity;
+        uint32_t Texture;
+        glm::vec4 Color;
+    };
+
+    struct CircleRendererRecord
+    {
+        uint32_t Entity;
+        float Thickness;
+        float Fade;
+        glm::vec4 Color;
+    };
+
+    struct MeshRendererRecord
+    {
+        uint32_t Entity;
+        uint32_t Mesh;
+        uint32_t FirstMaterial;
+        uint32_t MaterialCount;
+    };
+
+    struct MaterialRecord
+    {
+        glm::vec4 AlbedoColor;
+        glm::vec2 UVRepeat;
+        uint32_t AlbedoTexture;
+        uint32_t MetallicTexture;
+        uint32_t RoughnessTexture;
+        uint32_t NormalTexture;
+        uint32_t AOTexture;
+        uint32_t Padding;
+    };
+
+    struct DirectionalLightRecord
+    {
+        uint32_t Entity;
+        glm::vec3 Direction;
+    };
+
+    struct Rigidbody2DRecord
+    {
+        uint32_t Entity;
+        uint32_t Type;
+        uint32_t FixedRotation;
+    };
+
+    struct BoxCollider2DRecord
+    {
+        uint32_t Entity;
+        uint32_t Material;
+        glm::vec2 Offset;
+        glm::vec2 Size;
+    };
+
+    struct CircleCollider2DRecord
+    {
+        uint32_t Entity;
+        uint32_t Material;
+        glm::vec2 Offset;
+        float Radius;
+    };
+
+    struct ScriptRecord
+    {
+        uint32_t Entity;
+        uint32_t ClassName;
+        uint32_t FirstField;
+        uint32_t FieldCount;
+    };
+
+    // Field values are copied as the raw 16 byte buffer of ScriptFieldInstance
+    struct ScriptFieldData
+    {
+        uint8_t Bytes[16];
+    };
+
+    struct ScriptFieldRecord
+    {
+        uint32_t Name;
+        uint32_t Type;
+        ScriptFieldData Data;
+    };
+
+    // The records are read in place from the mapping, their layout must not depend on the compiler
+    static_assert(sizeof(BinarySceneHeader) == 16 && sizeof(BlockEntry) == 24);
+    static_assert(sizeof(StringRecord) == 8 && sizeof(EntityRecord) == 16);
+    static_assert(sizeof(TransformRecord) == 40 && sizeof(RelationshipRecord) == 24);
+    static_assert(sizeof(CameraRecord) == 36 && sizeof(SpriteRendererRecord) == 24);
+    static_assert(sizeof(CircleRendererRecord) == 28 && sizeof(MeshRendererRecord) == 16);
+    static_assert(sizeof(MaterialRecord) == 48 && sizeof(DirectionalLightRecord) == 16);
+    static_assert(sizeof(Rigidbody2DRecord) == 12 && sizeof(BoxCollider2DRecord) == 24);
+    static_assert(sizeof(CircleCollider2DRecord) == 20 && sizeof(ScriptRecord) == 16);
+    static_assert(sizeof(ScriptFieldRecord) == 24);
+
+    static uint64_t AlignBlockOffset(uint64_t offset)
+    {
+        return (offset + s_BlockAlignment - 1) & ~(s_BlockAlignment - 1);
+    }
+
+    class StringTableWriter
+    {
+    public:
+        uint32_t Add(const std::string& string)
+        {
+            if (string.empty())
+                return s_NoString;
+
+            auto it = m_Indices.find(string);
+            if (it != m_Indices.end())
+                return it->second;
+
+            uint32_t index = (uint32_t)m_Records.size();
+            m_Records.push_back({(uint32_t)m_Data.size(), (uint32_t)string.size()});
+            m_Data.insert(m_Data.end(), string.begin(), string.end());
+            m_Indices.emplace(string, index);
+            return index;
+        }
+
+        template <typename T>
+        uint32_t AddPath(const Ref<T>& asset)
+        {
+            return asset ? Add(asset->GetPath()) : s_NoString;
+        }
+
+        const std::vector<StringRecord>& GetRecords() const { return m_Records; }
+        const std::vector<char>& GetData() const { return m_Data; }
+
+    private:
+        std::unordered_map<std::string, uint32_t> m_Indices;
+        std::vector<StringRecord> m_Records;
+        std::vector<char> m_Data;
+    };
+
+    class BinarySceneWriter
+    {
+    public:
+        template <typename T>
+        void AddBlock(SceneBlock type, const std::vector<T>& records)
+        {
+            m_Blocks.push_back({(uint32_t)type, (uint32_t)records.size(), 0, records.size() * sizeof(T)});
+            m_BlockData.push_back(records.data());
+        }
+
+        bool Write(const std::filesystem::path& path, uint32_t entityCount)
+        {
+            uint64_t offset = sizeof(BinarySceneHeader) + m_Blocks.size() * sizeof(BlockEntry);
+            for (BlockEntry& block : m_Blocks)
+            {
+                offset = AlignBlockOffset(offset);
+                block.Offset = offset;
+                offset += block.Size;
+            }
+
+            std::vector<uint8_t> bytes(offset, 0);
+
+            BinarySceneHeader header;
+            memcpy(header.Magic, s_BinarySceneMagic, sizeof(header.Magic));
+            header.Version = s_BinarySceneVersion;
+            header.EntityCount = entityCount;
+            header.BlockCount = (uint32_t)m_Blocks.size();
+            memcpy(bytes.data(), &header, sizeof(header));
+            memcpy(bytes.data() + sizeof(header), m_Blocks.data(), m_Blocks.size() * sizeof(BlockEntry));
+
+            for (size_t i = 0; i < m_Blocks.size(); i++)
+            {
+                if (m_Blocks[i].Size)
+                    memcpy(bytes.data() + m_Blocks[i].Offset, m_BlockData[i], m_Blocks[i].Size);
+            }
+
+            // Written next to the target and renamed, a failed save never leaves a truncated scene behind
+            std::filesystem::path tempPath = path;
+            tempPath += ".tmp";
+            {
+                std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+                if (!out)
+                    return false;
+
+                out.write((const char*)bytes.data(), bytes.size());
+                if (!out)
+                    return false;
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(tempPath, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+
+            return true;
+        }
+
+    private:
+        std::vector<BlockEntry> m_Blocks;
+        std::vector<const void*> m_BlockData;
+    };
+
+    class BinarySceneReader
+    {
+    public:
+        BinarySceneReader(const MappedFile& file) : m_File(file) {}
+
+        bool ReadHeader()
+        {
+            if (!m_File.IsValid() || m_File.GetSize() < sizeof(BinarySceneHeader))
+                return false;
+
+            memcpy(&m_Header, m_File.GetData(), sizeof(BinarySceneHeader));
+            if (memcmp(m_Header.Magic, s_BinarySceneMagic, sizeof(m_Header.Magic)) != 0 ||
+                m_Header.Version != s_BinarySceneVersion)
+                return false;
+
+            const uint64_t tableEnd = sizeof(BinarySceneHeader) + (uint64_t)m_Header.BlockCount * sizeof(BlockEntry);
+            if (tableEnd > m_File.GetSize())
+                return false;
+
+            m_Blocks.resize(m_Header.BlockCount);
+            memcpy(m_Blocks.data(), m_File.GetData() + sizeof(BinarySceneHeader),
+                   m_Blocks.size() * sizeof(BlockEntry));
+            return true;
+        }
+
+        uint32_t GetEntityCount() const { return m_Header.EntityCount; }
+
+        // Empty when the block is missing or does not fit the file
+        template <typename T>
+        std::span<const T> GetBlock(SceneBlock type) const
+        {
+            for (const BlockEntry& block : m_Blocks)
+            {
+                if (block.Type != (uint32_t)type)
+                    continue;
+
+                if (block.Size != (uint64_t)block.Count * sizeof(T) || block.Offset % alignof(T) != 0 ||
+                    block.Offset + block.Size > m_File.GetSize())
+                {
+                    TI_CORE_WARN("Binary scene block {} is corrupt", block.Type);
+                    return {};
+                }
+
+                return {(const T*)(m_File.GetData() + block.Offset), block.Count};
+            }
+
+            return {};
+        }
+
+    private:
+        const MappedFile& m_File;
+        BinarySceneHeader m_Header{};
+        std::vector<BlockEntry> m_Blocks;
+    };
+
+    class StringTableReader
+    {
+    public:
+        StringTableReader(std::span<const StringRecord> records, std::span<const char> data)
+            : m_Records(records), m_Data(data)
+        {
+        }
+
+        std::string_view Get(uint32_t index) const
+        {
+            if (index >= m_Records.size())
+                return {};
+
+            const StringRecord& record = m_Records[index];
+            if ((uint64_t)record.Offset + record.Length > m_Data.size())
+                return {};
+
+            return {m_Data.data() + record.Offset, record.Length};
+        }
+
+        std::string GetString(uint32_t index) const { return std::string(Get(index)); }
+
+    private:
+        std::span<const StringRecord> m_Records;
+        std::span<const char> m_Data;
+    };
+
+    static Ref<Texture2D> LoadTexture(const StringTableReader& strings, uint32_t index)
+    {
+        std::string path = strings.GetString(index);
+        return path.empty() ? nullptr : Assets::Load<Texture2D>(path);
+    }
+
+    // Record entity indices come from the file, anything out of range is dropped rather than trusted
+    static entt::entity HandleOf(const std::vector<entt::entity>& handles, uint32_t index)
+    {
+        return index < handles.size() ? handles[index] : entt::null;
+    }
+
+    // Builds the component of every record and inserts them into the pool in one go
+    template <typename Component, typename Record, typename BuildFunction>
+    static void InsertComponents(entt::registry& registry, const std::vector<entt::entity>& handles,
+                                 std::span<const Record> records, BuildFunction build)
+    {
+        std::vector<entt::entity> targets;
+        std::vector<Component> components;
+        targets.reserve(records.size());
+        components.reserve(records.size());
+
+        // A corrupt file can list an entity twice, the pool is only filled at the end so the batch is checked
+        std::vector<bool> seen(handles.size());
+        for (const Record& record : records)
+        {
+            entt::entity entity = HandleOf(handles, record.Entity);
+            if (entity == entt::null || seen[record.Entity] || registry.all_of<Component>(entity))
+                continue;
+
+            seen[record.Entity] = true;
+            targets.push_back(entity);
+            build(components.emplace_back(), record);
+        }
+
+        registry.insert<Component>(targets.begin(), targets.end(), components.begin());
+    }
+
+    bool SceneSerializer::IsRuntimeScene(const std::filesystem::path& filepath)
+    {
+        return filepath.extension() == ".titanbin";
+    }
+
+    bool SceneSerializer::CollectRuntimeAssetPaths(const std::string& filepath, SceneAssetPaths& paths)
+    {
+        MappedFile file(filepath);
+        BinarySceneReader reader(file);
+        if (!reader.ReadHeader())
+            return false;
+
+        StringTableReader strings(reader.GetBlock<StringRecord>(SceneBlock::Strings),
+                                  reader.GetBlock<char>(SceneBlock::StringData));
+        auto addTexture = [&](uint32_t index)
+        {
+            if (index != s_NoString)
+                paths.Textures.push_back(strings.GetString(index));
+        };
+
+        for (const SpriteRendererRecord& record : reader.GetBlock<SpriteRendererRecord>(SceneBlock::SpriteRenderers))
+            addTexture(record.Texture);
+
+        for (const MeshRendererRecord& record : reader.GetBlock<MeshRendererRecord>(SceneBlock::MeshRenderers))
+        {
+            std::string_view mesh = strings.Get(record.Mesh);
+            if (!mesh.empty() && mesh != "quad" && mesh != "cube")
+                paths.Meshes.emplace_back(mesh);
+        }
+
+        for (const MaterialRecord& record : reader.GetBlock<MaterialRecord>(SceneBlock::Materials))
+        {
+            addTexture(record.AlbedoTexture);
+            addTexture(record.MetallicTexture);
+            addTexture(record.RoughnessTexture);
+            addTexture(record.NormalTexture);
+            addTexture(record.AOTexture);
+        }
+
+        return true;
+    }
+
+    void SceneSerializer::SerializeRuntime(const std::string& filepath)
+    {
+        TI_PROFILE_FUNCTION();
+        TI_CORE_ASSERT(!filepath.empty(), "SceneSerializer::SerializeRuntime - Filepath is empty!");
+        TI_CORE_ASSERT(m_Scene, "SceneSerializer::SerializeRuntime - Scene is null!");
+
+        Timer timer;
+        auto& registry = m_Scene->m_Registry;
+
+        StringTableWriter strings;
+        std::vector<EntityRecord> entities;
+        std::unordered_map<entt::entity, uint32_t> entityIndices;
+
+        auto idView = registry.view<IDComponent>();
+        entities.reserve(idView.size());
+        entityIndices.reserve(idView.size());
+        for (auto entity : idView)
+        {
+            const std::string* tag =
+                registry.all_of<TagComponent>(entity) ? &registry.get<TagComponent>(entity).Tag : nullptr;
+            entityIndices.emplace(entity, (uint32_t)entities.size());
+            entities.push_back({(uint64_t)idView.get<IDComponent>(entity).ID, tag ? strings.Add(*tag) : s_NoString});
+        }
+
+        // Components of entities without an ID are skipped like the entities themselves
+        auto indexOf = [&entityIndices](entt::entity entity, uint32_t& index)
+        {
+            auto it = entityIndices.find(entity);
+            if (it == entityIndices.end())
+                return false;
+            index = it->second;
+            return true;
+        };
+
+        std::vector<TransformRecord> transforms;
+        for (auto [entity, tc] : registry.view<TransformComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                transforms.push_back({index, tc.Translation, tc.Rotation, tc.Scale});
+        }
+
+        std::vector<RelationshipRecord> relationships;
+        std::vector<uint64_t> children;
+        for (auto [entity, rc] : registry.view<RelationshipComponent>().each())
+        {
+            uint32_t index;
+            if (!indexOf(entity, index) || (!rc.Parent && rc.Children.empty()))
+                continue;
+
+            relationships.push_back({index, (uint32_t)children.size(), (uint32_t)rc.Children.size(), 0,
+                                     (uint64_t)rc.Parent});
+            for (UUID child : rc.Children)
+                children.push_back((uint64_t)child);
+        }
+
+        std::vector<CameraRecord> cameras;
+        for (auto [entity, cc] : registry.view<CameraComponent>().each())
+        {
+            uint32_t index;
+            if (!indexOf(entity, index))
+                continue;
+
+            const SceneCamera& camera = cc.Camera;
+            cameras.push_back({index,
+                               (int32_t)camera.GetProjectionType(),
+                               camera.GetPerspectiveVerticalFOV(),
+                               camera.GetPerspectiveNearClip(),
+                               camera.GetPerspectiveFarClip(),
+                               camera.GetOrthographicSize(),
+                               camera.GetOrthographicNearClip(),
+                               camera.GetOrthographicFarClip(),
+                               (uint8_t)cc.Primary,
+                               (uint8_t)cc.FixedAspectRatio,
+                               {}});
+        }
+
+        std::vector<SpriteRendererRecord> sprites;
+        for (auto [entity, src] : registry.view<SpriteRendererComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                sprites.push_back({index, strings.AddPath(src.Tex), src.Color});
+        }
+
+        std::vector<CircleRendererRecord> circles;
+        for (auto [entity, crc] : registry.view<CircleRendererComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                circles.push_back({index, crc.Thickness, crc.Fade, crc.Color});
+        }
+
+        std::vector<MeshRendererRecord> meshRenderers;
+        std::vector<MaterialRecord> materials;
+        for (auto [entity, mrc] : registry.view<MeshRendererComponent>().each())
+        {
+            uint32_t index;
+            if (!indexOf(entity, index))
+                continue;
+
+            MeshRendererRecord& record = meshRenderers.emplace_back();
+            record = {index, s_NoString, (uint32_t)materials.size(), 0};
+            if (!mrc.MeshRef)
+                continue;
+
+            record.Mesh = strings.Add(mrc.MeshRef->GetFilePath());
+            for (auto mat : mrc.MeshRef->GetMaterials())
+            {
+                materials.push_back({mat->AlbedoColor, mat->UVRepeat, strings.AddPath(mat->AlbedoTexture),
+                                     strings.AddPath(mat->MetallicTexture), strings.AddPath(mat->RoughnessTexture),
+                                     strings.AddPath(mat->NormalTexture), strings.AddPath(mat->AOTexture), 0});
+                record.MaterialCount++;
+            }
+        }
+
+        std::vector<DirectionalLightRecord> lights;
+        for (auto [entity, dlc] : registry.view<DirectionalLightComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                lights.push_back({index, dlc.Direction});
+        }
+
+        std::vector<Rigidbody2DRecord> rigidbodies;
+        for (auto [entity, rb2d] : registry.view<Rigidbody2DComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                rigidbodies.push_back({index, (uint32_t)rb2d.Type, (uint32_t)rb2d.FixedRotation});
+        }
+
+        std::vector<BoxCollider2DRecord> boxColliders;
+        for (auto [entity, bc2d] : registry.view<BoxCollider2DComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                boxColliders.push_back(
+                    {index, bc2d.Material ? strings.Add(bc2d.Material->SourcePath) : s_NoString, bc2d.Offset,
+                     bc2d.Size});
+        }
+
+        std::vector<CircleCollider2DRecord> circleColliders;
+        for (auto [entity, cc2d] : registry.view<CircleCollider2DComponent>().each())
+        {
+            uint32_t index;
+            if (indexOf(entity, index))
+                circleColliders.push_back(
+                    {index, cc2d.Material ? strings.Add(cc2d.Material->SourcePath) : s_NoString, cc2d.Offset,
+                     cc2d.Radius});
+        }
+
+        std::vector<ScriptRecord> scripts;
+        std::vector<ScriptFieldRecord> scriptFields;
+        for (auto [entity, sc] : registry.view<ScriptComponent>().each())
+        {
+            uint32_t index;
+            if (!indexOf(entity, index))
+                continue;
+
+            ScriptRecord& record = scripts.emplace_back();
+            record = {index, strings.Add(sc.ClassName), (uint32_t)scriptFields.size(), 0};
+
+            Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
+            if (!entityClass || entityClass->GetFields().empty())
+                continue;
+
+            auto& entityFields = ScriptEngine::GetScriptFieldMap({entity, m_Scene.get()});
+            for (const auto& [name, field] : entityClass->GetFields())
+            {
+                auto it = entityFields.find(name);
+                if (it == entityFields.end())
+                    continue;
+
+                scriptFields.push_back(
+                    {strings.Add(name), (uint32_t)field.Type, it->second.GetValue<ScriptFieldData>()});
+                record.FieldCount++;
+            }
+        }
+
+        BinarySceneWriter writer;
+        writer.AddBlock(SceneBlock::Strings, strings.GetRecords());
+        writer.AddBlock(SceneBlock::StringData, strings.GetData());
+        writer.AddBlock(SceneBlock::Entities, entities);
+        writer.AddBlock(SceneBlock::Transforms, transforms);
+        writer.AddBlock(SceneBlock::Relationships, relationships);
+        writer.AddBlock(SceneBlock::Children, children);
+        writer.AddBlock(SceneBlock::Cameras, cameras);
+        writer.AddBlock(SceneBlock::SpriteRenderers, sprites);
+        writer.AddBlock(SceneBlock::CircleRenderers, circles);
+        writer.AddBlock(SceneBlock::MeshRenderers, meshRenderers);
+        writer.AddBlock(SceneBlock::Materials, materials);
+        writer.AddBlock(SceneBlock::DirectionalLights, lights);
+        writer.AddBlock(SceneBlock::Rigidbodies2D, rigidbodies);
+        writer.AddBlock(SceneBlock::BoxColliders2D, boxColliders);
+        writer.AddBlock(SceneBlock::CircleColliders2D, circleColliders);
+        writer.AddBlock(SceneBlock::Scripts, scripts);
+        writer.AddBlock(SceneBlock::ScriptFields, scriptFields);
+
+        if (!writer.Write(filepath, (uint32_t)entities.size()))
+        {
+            TI_CORE_WARN("Could not write binary scene {}", filepath);
+            return;
+        }
+
+        TI_CORE_INFO("Saved binary scene to {} ({} entities, {:.2f}ms)", filepath, entities.size(),
+                     timer.ElapsedMillis());
+    }
+
+    bool SceneSerializer::DeserializeRuntime(const std::string& filepath)
+    {
+        TI_PROFILE_FUNCTION();
+
+        Timer timer;
+        MappedFile file(filepath);
+        BinarySceneReader reader(file);
+        if (!reader.ReadHeader())
+        {
+            TI_CORE_WARN("{} is not a binary scene of version {}", filepath, s_BinarySceneVersion);
+            return false;
+        }
+
+        StringTableReader strings(reader.GetBlock<StringRecord>(SceneBlock::Strings),
+                                  reader.GetBlock<char>(SceneBlock::StringData));
+        auto entityRecords = reader.GetBlock<EntityRecord>(SceneBlock::Entities);
+        if (entityRecords.size() != reader.GetEntityCount())
+        {
+            TI_CORE_WARN("Binary scene {} is corrupt", filepath);
+            return false;
+        }
+
+        // Headless runs have no graphics context, render components are kept without their GPU assets
+        const bool loadRenderAssets = RendererAPI::GetAPI() != RendererAPI::API::None;
+
+        auto& registry = m_Scene->m_Registry;
+        const size_t entityCount = entityRecords.size();
+
+        // Entities and the components every entity has are created in bulk, each pool grows once
+        std::vector<entt::entity> handles(entityCount);
+        registry.create(handles.begin(), handles.end());
+
+        {
+            std::vector<IDComponent> ids(entityCount);
+            std::vector<TagComponent> tags(entityCount);
+            m_Scene->m_EntityMap.reserve(m_Scene->m_EntityMap.size() + entityCount);
+            for (size_t i = 0; i < entityCount; i++)
+            {
+                ids[i].ID = entityRecords[i].ID;
+                tags[i].Tag = strings.GetString(entityRecords[i].Tag);
+                if (tags[i].Tag.empty())
+                    tags[i].Tag = "Entity";
+                m_Scene->m_EntityMap[ids[i].ID] = handles[i];
+            }
+
+            registry.insert<IDComponent>(handles.begin(), handles.end(), ids.begin());
+            registry.insert<TagComponent>(handles.begin(), handles.end(), tags.begin());
+            registry.insert<TransformComponent>(handles.begin(), handles.end());
+            registry.insert<RelationshipComponent>(handles.begin(), handles.end());
+            registry.insert<WorldTransformComponent>(handles.begin(), handles.end());
+        }
+
+        for (const TransformRecord& record : reader.GetBlock<TransformRecord>(SceneBlock::Transforms))
+        {
+            entt::entity entity = HandleOf(handles, record.Entity);
+            if (entity == entt::null)
+                continue;
+
+            auto& tc = registry.get<TransformComponent>(entity);
+            tc.Translation = record.Translation;
+            tc.Rotation = record.Rotation;
+            tc.Scale = record.Scale;
+        }
+
+        auto children = reader.GetBlock<uint64_t>(SceneBlock::Children);
+        for (const RelationshipRecord& record : reader.GetBlock<RelationshipRecord>(SceneBlock::Relationships))
+        {
+            entt::entity entity = HandleOf(handles, record.Entity);
+            if (entity == entt::null || (uint64_t)record.FirstChild + record.ChildCount > children.size())
+                continue;
+
+            auto& rc = registry.get<RelationshipComponent>(entity);
+            rc.Parent = record.Parent;
+            rc.Children.assign(children.begin() + record.FirstChild,
+                               children.begin() + record.FirstChild + record.ChildCount);
+        }
+
+        InsertComponents<CameraComponent>(
+            registry, handles, reader.GetBlock<CameraRecord>(SceneBlock::Cameras),
+            [this](CameraComponent& cc, const CameraRecord& record)
+            {
+                cc.Camera.SetProjectionType((SceneCamera::ProjectionType)record.ProjectionType);
+                cc.Camera.SetPerspectiveVerticalFOV(record.PerspectiveFOV);
+                cc.Camera.SetPerspectiveNearClip(record.PerspectiveNear);
+                cc.Camera.SetPerspectiveFarClip(record.PerspectiveFar);
+                cc.Camera.SetOrthographicSize(record.OrthographicSize);
+                cc.Camera.SetOrthographicNearClip(record.OrthographicNear);
+                cc.Camera.SetOrthographicFarClip(record.OrthographicFar);
+                cc.Primary = record.Primary;
+                cc.FixedAspectRatio = record.FixedAspectRatio;
+
+                // Bulk inserts bypass Scene::OnComponentAdded
+                cc.Camera.SetViewportSize(m_Scene->m_ViewportWidth, m_Scene->m_ViewportHeight);
+            });
+
+        InsertComponents<SpriteRendererComponent>(
+            registry, handles, reader.GetBlock<SpriteRendererRecord>(SceneBlock::SpriteRenderers),
+            [&](SpriteRendererComponent& src, const SpriteRendererRecord& record)
+            {
+                src.Color = record.Color;
+                if (loadRenderAssets)
+                    src.Tex = LoadTexture(strings, record.Texture);
+            });
+
+        InsertComponents<CircleRendererComponent>(
+            registry, handles, reader.GetBlock<CircleRendererRecord>(SceneBlock::CircleRenderers),
+            [](CircleRendererComponent& crc, const CircleRendererRecord& record)
+            {
+                crc.Color = record.Color;
+                crc.Thickness = record.Thickness;
+                crc.Fade = record.Fade;
+            });
+
+        auto materials = reader.GetBlock<MaterialRecord>(SceneBlock::Materials);
+        InsertComponents<MeshRendererComponent>(
+            registry, handles, reader.GetBlock<MeshRendererRecord>(SceneBlock::MeshRenderers),
+            [&](MeshRendererComponent& mrc, const MeshRendererRecord& record)
+            {
+                std::string path = strings.GetString(record.Mesh);
+                if (path.empty() || !loadRenderAssets)
+                    return;
+
+                if (path == "quad")
+                    mrc.MeshRef = Mesh::CreateQuad();
+                else if (path == "cube")
+                    mrc.MeshRef = Mesh::CreateCube();
+                else
+                    mrc.MeshRef = Assets::Load<Mesh>(path);
+
+                if (!mrc.MeshRef || (uint64_t)record.FirstMaterial + record.MaterialCount > materials.size())
+                    return;
+
+                // The mesh file may have changed since the scene was saved
+                const uint32_t materialCount =
+                    (std::min)(record.MaterialCount, (uint32_t)mrc.MeshRef->GetMaterials().size());
+                for (uint32_t i = 0; i < materialCount; i++)
+                {
+                    const MaterialRecord& material = materials[record.FirstMaterial + i];
+                    auto mat = mrc.MeshRef->GetMaterial(i);
+                    mat->AlbedoColor = material.AlbedoColor;
+                    mat->UVRepeat = material.UVRepeat;
+                    mat->AlbedoTexture = LoadTexture(strings, material.AlbedoTexture);
+                    mat->MetallicTexture = LoadTexture(strings, material.MetallicTexture);
+                    mat->RoughnessTexture = LoadTexture(strings, material.RoughnessTexture);
+                    mat->NormalTexture = LoadTexture(strings, material.NormalTexture);
+                    mat->AOTexture = LoadTexture(strings, material.AOTexture);
+                }
+            });
+
+        InsertComponents<DirectionalLightComponent>(
+            registry, handles, reader.GetBlock<DirectionalLightRecord>(SceneBlock::DirectionalLights),
+            [](DirectionalLightComponent& dlc, const DirectionalLightRecord& record)
+            { dlc.Direction = record.Direction; });
+
+        InsertComponents<Rigidbody2DComponent>(
+            registry, handles, reader.GetBlock<Rigidbody2DRecord>(SceneBlock::Rigidbodies2D),
+            [](Rigidbody2DComponent& rb2d, const Rigidbody2DRecord& record)
+            {
+                rb2d.Type = (Rigidbody2DComponent::BodyType)record.Type;
+                rb2d.FixedRotation = record.FixedRotation;
+            });
+
+        InsertComponents<BoxCollider2DComponent>(
+            registry, handles, reader.GetBlock<BoxCollider2DRecord>(SceneBlock::BoxColliders2D),
+            [&](BoxCollider2DComponent& bc2d, const BoxCollider2DRecord& record)
+            {
+                bc2d.Offset = record.Offset;
+                bc2d.Size = record.Size;
+                if (record.Material != s_NoString)
+                    bc2d.Material = Assets::Load<Physics2DMaterial>(strings.GetString(record.Material));
+            });
+
+        InsertComponents<CircleCollider2DComponent>(
+            registry, handles, reader.GetBlock<CircleCollider2DRecord>(SceneBlock::CircleColliders2D),
+            [&](CircleCollider2DComponent& cc2d, const CircleCollider2DRecord& record)
+            {
+                cc2d.Offset = record.Offset;
+                cc2d.Radius = record.Radius;
+                if (record.Material != s_NoString)
+                    cc2d.Material = Assets::Load<Physics2DMaterial>(strings.GetString(record.Material));
+            });
+
+        auto scriptRecords = reader.GetBlock<ScriptRecord>(SceneBlock::Scripts);
+        InsertComponents<ScriptComponent>(
+            registry, handles, scriptRecords, [&](ScriptComponent& sc, const ScriptRecord& record)
+            { sc.ClassName = strings.GetString(record.ClassName); });
+
+        // Field values live in the script engine, not in the registry
+        auto scriptFields = reader.GetBlock<ScriptFieldRecord>(SceneBlock::ScriptFields);
+        for (const ScriptRecord& record : scriptRecords)
+        {
+            entt::entity entity = HandleOf(handles, record.Entity);
+            if (entity == entt::null || !record.FieldCount ||
+                (uint64_t)record.FirstField + record.FieldCount > scriptFields.size())
+                continue;
+
+            Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(strings.GetString(record.ClassName));
+            if (!entityClass)
+                continue;
+
+            const auto& fields = entityClass->GetFields();
+            auto& entityFields = ScriptEngine::GetScriptFieldMap({entity, m_Scene.get()});
+            for (uint32_t i = 0; i < record.FieldCount; i++)
+            {
+                const ScriptFieldRecord& fieldRecord = scriptFields[record.FirstField + i];
+                std::string name = strings.GetString(fieldRecord.Name);
+                auto field = fields.find(name);
+                if (field == fields.end() || (uint32_t)field->second.Type != fieldRecord.Type)
+                    continue;
+
+                ScriptFieldInstance& fieldInstance = entityFields[name];
+                fieldInstance.Field = field->second;
+                fieldInstance.SetValue(fieldRecord.Data);
+            }
+        }
+
+        m_Scene->m_HierarchyDirty = true;
+        m_Scene->m_NameIndexDirty = true;
+
+        TI_CORE_INFO("Loaded binary scene {} ({} entities, {:.2f}ms)", filepath, entityCount, timer.ElapsedMillis());
+        return true;
+    }
+
+} // namespace Titan
@@ -20,6 +20,9 @@ namespace Titan
         virtual void OnCreate() {}
         virtual void OnDestroy() {}
         virtual void OnUpdate(Timestep ts) {}
+        // Called after the physics step in which a collider of this entity started or stopped touching other
+        virtual void OnCollisionEnter(Entity other) {}
+        virtual void OnCollisionExit(Entity other) {}
 
     private:
         Entity m_Entity;
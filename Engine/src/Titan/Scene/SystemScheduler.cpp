@@ -0,0 +1,95 @@
+#include "SystemScheduler.h"
+#include "Titan/Core/JobSystem.h"
+#include "Titan/Core/Timer.h"
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    static bool Overlaps(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b)
+    {
+        for (entt::id_type type : a)
+        {
+            if (std::find(b.begin(), b.end(), type) != b.end())
+                return true;
+        }
+        return false;
+    }
+
+    bool SceneSystem::ConflictsWith(const SceneSystem& other) const
+    {
+        if (m_Exclusive || other.m_Exclusive)
+            return true;
+
+        // Reading the same components is fine, any write makes the order matter
+        return Overlaps(m_Writes, other.m_Writes) || Overlaps(m_Writes, other.m_Reads) ||
+               Overlaps(m_Reads, other.m_Writes);
+    }
+
+    SceneSystem& SystemScheduler::Add(const std::string& name, SceneSystem::UpdateFunction update)
+    {
+        return *m_Systems.emplace_back(CreateScope<SceneSystem>(name, std::move(update)));
+    }
+
+    void SystemScheduler::BuildStages()
+    {
+        TI_PROFILE_FUNCTION();
+
+        m_Stages.clear();
+
+        std::vector<uint32_t> systemStage(m_Systems.size(), 0);
+        for (size_t i = 0; i < m_Systems.size(); i++)
+        {
+            uint32_t stage = 0;
+            for (size_t j = 0; j < i; j++)
+            {
+                if (m_Systems[i]->ConflictsWith(*m_Systems[j]))
+                    stage = (std::max)(stage, systemStage[j] + 1);
+            }
+
+            systemStage[i] = stage;
+            if (stage >= m_Stages.size())
+                m_Stages.resize(stage + 1);
+            m_Stages[stage].push_back(m_Systems[i].get());
+        }
+    }
+
+    void SystemScheduler::RunSystem(SceneSystem& system, Scene& scene, Timestep ts)
+    {
+        TI_PROFILE_FUNCTION();
+
+        Timer timer;
+        system.m_Update(scene, ts);
+        system.m_LastMillis = timer.ElapsedMillis();
+    }
+
+    void SystemScheduler::Run(Scene& scene, Timestep ts)
+    {
+        TI_PROFILE_FUNCTION();
+
+        // Access declarations can change between frames, the graph is small enough to rebuild every time
+        BuildStages();
+
+        for (auto& stage : m_Stages)
+        {
+            JobCounter counter;
+            for (SceneSystem* system : stage)
+            {
+                if (system->m_MainThread || stage.size() == 1)
+                    continue;
+
+                JobSystem::Execute([system, &scene, ts]() { RunSystem(*system, scene, ts); }, &counter);
+            }
+
+            // Main thread systems, and stages with a single system, run here while the jobs are in flight
+            for (SceneSystem* system : stage)
+            {
+                if (system->m_MainThread || stage.size() == 1)
+                    RunSystem(*system, scene, ts);
+            }
+
+            JobSystem::Wait(counter);
+        }
+    }
+
+} // namespace Titan
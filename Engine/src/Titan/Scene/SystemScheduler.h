@@ -0,0 +1,88 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "Titan/Core/Timestep.h"
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+    class Scene;
+
+    // A unit of per frame scene work. The component types a system reads and writes decide which systems
+    // the scheduler may run at the same time, declare everything the update touches.
+    class TI_API SceneSystem
+    {
+    public:
+        using UpdateFunction = std::function<void(Scene& scene, Timestep ts)>;
+
+        SceneSystem(const std::string& name, UpdateFunction update) : m_Name(name), m_Update(std::move(update)) {}
+
+        template <typename... Components>
+        SceneSystem& Reads()
+        {
+            (m_Reads.push_back(entt::type_hash<Components>::value()), ...);
+            return *this;
+        }
+
+        template <typename... Components>
+        SceneSystem& Writes()
+        {
+            (m_Writes.push_back(entt::type_hash<Components>::value()), ...);
+            return *this;
+        }
+
+        // The system may touch any component (scripts), it runs with no other system
+        SceneSystem& Exclusive()
+        {
+            m_Exclusive = true;
+            return *this;
+        }
+
+        // The system has to run on the thread updating the scene (Mono, OpenGL)
+        SceneSystem& OnMainThread()
+        {
+            m_MainThread = true;
+            return *this;
+        }
+
+        bool ConflictsWith(const SceneSystem& other) const;
+
+        const std::string& GetName() const { return m_Name; }
+        float GetLastMillis() const { return m_LastMillis; }
+
+    private:
+        std::string m_Name;
+        UpdateFunction m_Update;
+        std::vector<entt::id_type> m_Reads;
+        std::vector<entt::id_type> m_Writes;
+        bool m_Exclusive = false;
+        bool m_MainThread = false;
+
+        float m_LastMillis = 0.0f;
+
+        friend class SystemScheduler;
+    };
+
+    // Runs the systems of a scene in registration order, except that systems without conflicting component access
+    // run concurrently on the job system. Every frame the systems are grouped into stages: a system goes into the
+    // stage after the last earlier system it conflicts with.
+    class TI_API SystemScheduler
+    {
+    public:
+        SceneSystem& Add(const std::string& name, SceneSystem::UpdateFunction update);
+
+        void Run(Scene& scene, Timestep ts);
+
+        const std::vector<Scope<SceneSystem>>& GetSystems() const { return m_Systems; }
+
+    private:
+        void BuildStages();
+        static void RunSystem(SceneSystem& system, Scene& scene, Timestep ts);
+
+    private:
+        // Scope so the references handed out by Add stay valid
+        std::vector<Scope<SceneSystem>> m_Systems;
+        std::vector<std::vector<SceneSystem*>> m_Stages;
+    };
+
+} // namespace Titan
@@ -1,14 +1,25 @@
 #include "ScriptEngine.h"
+#include <atomic>
 #include "FileWatch.hpp"
 #include "ScriptGlue.h"
 #include "Titan/Core/Application.h"
+#include "Titan/Core/JobSystem.h"
 #include "Titan/Core/Timer.h"
 #include "Titan/PCH.h"
 #include "Titan/Scene/Components.h"
+#include "Titan/Utils/FileSystem.h"
 #include "mono/jit/jit.h"
 #include "mono/metadata/assembly.h"
 #include "mono/metadata/object.h"
+#include "mono/metadata/profiler.h"
 #include "mono/metadata/tabledefs.h"
+#include "mono/metadata/threads.h"
+
+// Mono leaves the profiler state to the embedder, the counters live in ScriptEngineData
+struct _MonoProfiler
+{
+    int Unused;
+};
 
 namespace Titan
 {
@@ -30,59 +41,32 @@ namespace Titan
     namespace Utils
     {
 
-        // TODO: move to FileSystem class
-        static char* ReadBytes(const std::filesystem::path& filepath, uint32_t* outSize)
+        static MonoAssembly* LoadMonoAssembly(const std::filesystem::path& assemblyPath)
         {
-            std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
-
-            if (!stream)
-            {
-                // Failed to open the file
-                return nullptr;
-            }
-
-            std::streampos end = stream.tellg();
-            stream.seekg(0, std::ios::beg);
-            uint64_t size = end - stream.tellg();
-
-            if (size == 0)
+            MappedFile file(assemblyPath);
+            if (!file.IsValid())
             {
-                // File is empty
+                TI_CORE_ERROR("Could not read assembly {}", assemblyPath.string());
                 return nullptr;
             }
 
-            char* buffer = new char[size];
-            stream.read((char*)buffer, size);
-            stream.close();
-
-            *outSize = (uint32_t)size;
-            return buffer;
-        }
-
-        static MonoAssembly* LoadMonoAssembly(const std::filesystem::path& assemblyPath)
-        {
-            uint32_t fileSize = 0;
-            char* fileData = ReadBytes(assemblyPath, &fileSize);
-
             // NOTE: We can't use this image for anything other than loading the assembly because this image doesn't
-            // have a reference to the assembly
+            // have a reference to the assembly. Mono copies the data, so the mapping can go once the image is open.
+            // The image is named after the file, Mono looks for an AOT image next to that path.
+            std::string pathString = std::filesystem::absolute(assemblyPath).string();
             MonoImageOpenStatus status;
-            MonoImage* image = mono_image_open_from_data_full(fileData, fileSize, 1, &status, 0);
+            MonoImage* image = mono_image_open_from_data_with_name((char*)file.GetData(), (uint32_t)file.GetSize(), 1,
+                                                                   &status, 0, pathString.c_str());
 
             if (status != MONO_IMAGE_OK)
             {
-                const char* errorMessage = mono_image_strerror(status);
-                // Log some error message using the errorMessage data
+                TI_CORE_ERROR("Could not open assembly {}: {}", assemblyPath.string(), mono_image_strerror(status));
                 return nullptr;
             }
 
-            std::string pathString = assemblyPath.string();
             MonoAssembly* assembly = mono_assembly_load_from_full(image, pathString.c_str(), &status, 0);
             mono_image_close(image);
 
-            // Don't forget to free the file data
-            delete[] fileData;
-
             return assembly;
         }
 
@@ -119,6 +103,43 @@ namespace Titan
 
     } // namespace Utils
 
+    // Every instance of one batched class, the array is held through a GC handle while the runtime runs
+    struct ScriptBatch
+    {
+        Ref<ScriptClass> Class;
+        uint32_t ArrayHandle = 0;
+        uint32_t Count = 0;
+    };
+
+    // One entry per entity and contact, laid out like Titan.ContactData
+    struct ScriptContact
+    {
+        uint64_t OtherID;
+        uint32_t Began;
+    };
+    static_assert(sizeof(ScriptContact) == 16, "ScriptContact must match the managed ContactData");
+
+    // Both assemblies loaded into their own domain and reflected, ready to replace the current ones
+    struct PreparedAssemblies
+    {
+        std::filesystem::path CoreAssemblyFilepath;
+        std::filesystem::path AppAssemblyFilepath;
+
+        MonoDomain* AppDomain = nullptr;
+        MonoAssembly* CoreAssembly = nullptr;
+        MonoImage* CoreAssemblyImage = nullptr;
+        MonoAssembly* AppAssembly = nullptr;
+        MonoImage* AppAssemblyImage = nullptr;
+
+        ScriptClass EntityClass;
+        ScriptContactThunk DispatchCollisionsThunk = nullptr;
+        std::unordered_map<std::string, Ref<ScriptClass>> EntityClasses;
+
+        bool Loaded = false;
+        float LoadMillis = 0.0f;
+        float ReflectionMillis = 0.0f;
+    };
+
     struct ScriptEngineData
     {
         MonoDomain* RootDomain = nullptr;
@@ -134,18 +155,206 @@ namespace Titan
         std::filesystem::path AppAssemblyFilepath;
 
         ScriptClass EntityClass;
+        ScriptContactThunk DispatchCollisionsThunk = nullptr;
 
         std::unordered_map<std::string, Ref<ScriptClass>> EntityClasses;
-        std::unordered_map<UUID, Ref<ScriptInstance>> EntityInstances;
         std::unordered_map<UUID, ScriptFieldMap> EntityScriptFields;
 
+        // Reused by OnContactEvents
+        std::vector<MonoObject*> ContactEntities;
+        std::vector<MonoObject*> ContactOthers;
+        std::vector<ScriptContact> Contacts;
+
+        // Rebuilt before the next update once scripts were created or destroyed
+        std::vector<ScriptBatch> ScriptBatches;
+        bool ScriptBatchesDirty = false;
+
+        // Written by the profiler callbacks, which may run on any managed thread
+        MonoProfiler Profiler;
+        std::atomic<uint64_t> AllocatedBytes = 0;
+        std::atomic<uint32_t> Allocations = 0;
+        std::atomic<uint32_t> GCCount = 0;
+        std::atomic<uint64_t> GCMicros = 0;
+        std::chrono::steady_clock::time_point GCStart;
+
         Scope<filewatch::FileWatch<std::string>> AppAssemblyFileWatcher;
         bool AssemblyReloadPending = false;
 
+        // Written by the reload job, the main thread only reads it once the job handed over
+        Scope<PreparedAssemblies> PendingAssemblies;
+        JobCounter ReloadCounter;
+        bool ReloadInProgress = false;
+        bool ReloadQueued = false;
+
+        // Where JIT compilation shows up when scripts run without AOT images
+        bool FirstUpdatePending = false;
+
         Scene* SceneContext = nullptr;
     };
 
     static ScriptEngineData* s_Data = nullptr;
+    // Outside s_Data too, managed code keeps a pointer to it across assembly reloads
+    static uint32_t s_SceneGeneration = 0;
+    // Outside s_Data, it is set before Init
+    static ScriptAotMode s_AotMode = ScriptAotMode::None;
+
+    static const char* ScriptAotModeToString(ScriptAotMode mode)
+    {
+        switch (mode)
+        {
+            case ScriptAotMode::None:
+                return "JIT";
+            case ScriptAotMode::Normal:
+                return "AOT";
+            case ScriptAotMode::Hybrid:
+                return "hybrid AOT";
+        }
+        return "unknown";
+    }
+
+    // Allocations and collections on this thread are attributed to the class whose callback is running
+    static thread_local ScriptAllocationStats* s_ActiveClassStats = nullptr;
+
+    enum class ScriptCallbackKind
+    {
+        Create,
+        Update,
+        Destroy
+    };
+
+    // Wraps one call into managed code for a class. Allocations on this thread are attributed to the class for the
+    // duration, creation and batch update calls are also timed. Raw clock ticks are summed, only reports convert them.
+    struct ScriptCallbackScope
+    {
+        ScriptAllocationStats* PreviousStats;
+        ScriptTimingStats& Timing;
+        ScriptCallbackKind Kind;
+        std::chrono::steady_clock::time_point Start;
+
+        ScriptCallbackScope(ScriptClass* scriptClass, ScriptCallbackKind kind, uint32_t calls = 1)
+            : PreviousStats(s_ActiveClassStats), Timing(scriptClass->m_TimingStats), Kind(kind)
+        {
+            s_ActiveClassStats = &scriptClass->m_AllocationStats;
+            if (Kind == ScriptCallbackKind::Create)
+                Timing.CreateCalls += calls;
+            else if (Kind == ScriptCallbackKind::Update)
+                Timing.UpdateCalls += calls;
+
+            Start = std::chrono::steady_clock::now();
+        }
+
+        ~ScriptCallbackScope()
+        {
+            const uint64_t ticks = (std::chrono::steady_clock::now() - Start).count();
+            if (Kind == ScriptCallbackKind::Create)
+            {
+                Timing.CreateTicks += ticks;
+            }
+            else if (Kind == ScriptCallbackKind::Update)
+            {
+                Timing.UpdateTicks += ticks;
+                Timing.FrameTicks += ticks;
+            }
+
+            s_ActiveClassStats = PreviousStats;
+        }
+    };
+
+    // Times the per instance update calls of a frame. Consecutive instances of one class share a run, which reads the
+    // clock only where the class changes, instead of twice around every call. Allocations are attributed like in
+    // ScriptCallbackScope.
+    struct ScriptUpdateRun
+    {
+        ScriptAllocationStats* PreviousStats = s_ActiveClassStats;
+        ScriptClass* Class = nullptr;
+        uint32_t Calls = 0;
+        std::chrono::steady_clock::time_point Start;
+
+        ~ScriptUpdateRun()
+        {
+            if (Class)
+                End(std::chrono::steady_clock::now());
+            s_ActiveClassStats = PreviousStats;
+        }
+
+        void Add(ScriptClass* scriptClass)
+        {
+            if (scriptClass == Class)
+            {
+                Calls++;
+                return;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (Class)
+                End(now);
+
+            Class = scriptClass;
+            Calls = 1;
+            Start = now;
+            s_ActiveClassStats = &scriptClass->m_AllocationStats;
+        }
+
+        void End(std::chrono::steady_clock::time_point now)
+        {
+            const uint64_t ticks = (now - Start).count();
+            ScriptTimingStats& timing = Class->m_TimingStats;
+            timing.UpdateCalls += Calls;
+            timing.UpdateTicks += ticks;
+            timing.FrameTicks += ticks;
+        }
+    };
+
+    static float TicksToMillis(uint64_t ticks)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::duration(ticks)).count();
+    }
+
+#ifdef TI_ENABLE_SCRIPT_PROFILING
+    static void OnManagedAllocation(MonoProfiler* profiler, MonoObject* object)
+    {
+        const uint32_t size = mono_object_get_size(object);
+        s_Data->AllocatedBytes += size;
+        s_Data->Allocations++;
+
+        if (s_ActiveClassStats)
+        {
+            s_ActiveClassStats->AllocatedBytes += size;
+            s_ActiveClassStats->Allocations++;
+        }
+    }
+
+    static void OnGarbageCollection(MonoProfiler* profiler, MonoProfilerGCEvent event, uint32_t generation,
+                                    mono_bool isSerial)
+    {
+        // The pause is the time the world is stopped, the thread that triggered the collection runs the callbacks
+        if (event == MONO_GC_EVENT_PRE_STOP_WORLD)
+        {
+            s_Data->GCStart = std::chrono::steady_clock::now();
+        }
+        else if (event == MONO_GC_EVENT_POST_START_WORLD)
+        {
+            const auto pause = std::chrono::steady_clock::now() - s_Data->GCStart;
+            const uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(pause).count();
+            s_Data->GCCount++;
+            s_Data->GCMicros += micros;
+
+            if (s_ActiveClassStats)
+            {
+                s_ActiveClassStats->GCCount++;
+                s_ActiveClassStats->GCMillis += micros / 1000.0f;
+            }
+        }
+    }
+#endif
+
+    static void ReportException(MonoException* exception)
+    {
+        MonoString* message = mono_object_to_string((MonoObject*)exception, nullptr);
+        char* cStr = message ? mono_string_to_utf8(message) : nullptr;
+        TI_CORE_ERROR("Script exception: {}", cStr ? cStr : "unknown");
+        mono_free(cStr);
+    }
 
     static void OnAppAssemblyFileSystemEvent(const std::string& path, const filewatch::Event change_type)
     {
@@ -153,42 +362,72 @@ namespace Titan
         {
             s_Data->AssemblyReloadPending = true;
 
-            Application::GetInstance()->SubmitToMainThread(
-                []()
-                {
-                    s_Data->AppAssemblyFileWatcher.reset();
-                    ScriptEngine::ReloadAssembly();
-                });
+            Application::GetInstance()->SubmitToMainThread([]() { ScriptEngine::ReloadAssembly(); });
         }
     }
 
+    static void WatchAppAssembly()
+    {
+        if (s_AotMode == ScriptAotMode::Hybrid)
+            return;
+
+        s_Data->AppAssemblyFileWatcher = CreateScope<filewatch::FileWatch<std::string>>(
+            s_Data->AppAssemblyFilepath.string(), OnAppAssemblyFileSystemEvent);
+        s_Data->AssemblyReloadPending = false;
+    }
+
+    void ScriptEngine::SetAotMode(ScriptAotMode mode)
+    {
+        TI_CORE_ASSERT(!s_Data, "The AOT mode has to be set before the script engine starts");
+        s_AotMode = mode;
+    }
+
     void ScriptEngine::Init()
     {
+        Timer timer;
         s_Data = new ScriptEngineData();
 
         InitMono();
         ScriptGlue::RegisterFunctions();
 
-        LoadAssembly("resources/scripts/ScriptCore.dll");
-        LoadAppAssembly("resources/scripts/Sandbox.dll");
-        LoadAssemblyClasses();
+        PreparedAssemblies assemblies;
+        assemblies.CoreAssemblyFilepath = "resources/scripts/ScriptCore.dll";
+        assemblies.AppAssemblyFilepath = "resources/scripts/Sandbox.dll";
+        assemblies.Loaded = PrepareAssemblies(assemblies);
+        TI_CORE_ASSERT(assemblies.Loaded, "Could not load the script assemblies");
+        ApplyAssemblies(assemblies);
 
-        ScriptGlue::RegisterComponents();
-
-        // Retrieve and instantiate class
-        s_Data->EntityClass = ScriptClass("Titan", "Entity", true);
+        TI_CORE_INFO("Script engine started in {:.2f}ms ({})", timer.ElapsedMillis(), ScriptAotModeToString(s_AotMode));
     }
 
     void ScriptEngine::Shutdown()
     {
+        // A reload still preparing would hand over to an engine that is gone
+        JobSystem::Wait(s_Data->ReloadCounter);
+
         ShutdownMono();
         delete s_Data;
+        s_Data = nullptr;
     }
 
     void ScriptEngine::InitMono()
     {
         mono_set_assemblies_path("mono/lib");
 
+#ifdef TI_ENABLE_SCRIPT_PROFILING
+        // Has to be set up before the runtime starts
+        MonoProfilerHandle profiler = mono_profiler_create(&s_Data->Profiler);
+        mono_profiler_enable_allocations();
+        mono_profiler_set_gc_allocation_callback(profiler, OnManagedAllocation);
+        mono_profiler_set_gc_event_callback(profiler, OnGarbageCollection);
+#endif
+
+        // Has to be set before the runtime starts as well
+        if (s_AotMode == ScriptAotMode::Normal)
+            mono_jit_set_aot_mode(MONO_AOT_MODE_NORMAL);
+        else if (s_AotMode == ScriptAotMode::Hybrid)
+            mono_jit_set_aot_mode(MONO_AOT_MODE_HYBRID);
+
         MonoDomain* rootDomain = mono_jit_init("TitanJITRuntime");
         TI_CORE_ASSERT(rootDomain);
 
@@ -207,53 +446,172 @@ namespace Titan
         s_Data->RootDomain = nullptr;
     }
 
-    void ScriptEngine::LoadAssembly(const std::filesystem::path& filepath)
+    bool ScriptEngine::PrepareAssemblies(PreparedAssemblies& assemblies)
     {
-        // Create an App Domain
-        s_Data->AppDomain = mono_domain_create_appdomain((char*)"TitanScriptRuntime", nullptr);
-        mono_domain_set(s_Data->AppDomain, true);
+        TI_PROFILE_FUNCTION();
+
+        Timer timer;
 
-        // Move this maybe
-        s_Data->CoreAssemblyFilepath = filepath;
-        s_Data->CoreAssembly = Utils::LoadMonoAssembly(filepath);
-        s_Data->CoreAssemblyImage = mono_assembly_get_image(s_Data->CoreAssembly);
-        // Utils::PrintAssemblyTypes(s_Data->CoreAssembly);
+        // Only switches the calling thread, scripts running in the current domain are unaffected
+        assemblies.AppDomain = mono_domain_create_appdomain((char*)"TitanScriptRuntime", nullptr);
+        mono_domain_set(assemblies.AppDomain, true);
+
+        assemblies.CoreAssembly = Utils::LoadMonoAssembly(assemblies.CoreAssemblyFilepath);
+        assemblies.AppAssembly = Utils::LoadMonoAssembly(assemblies.AppAssemblyFilepath);
+        if (!assemblies.CoreAssembly || !assemblies.AppAssembly)
+            return false;
+
+        assemblies.CoreAssemblyImage = mono_assembly_get_image(assemblies.CoreAssembly);
+        assemblies.AppAssemblyImage = mono_assembly_get_image(assemblies.AppAssembly);
+        // Utils::PrintAssemblyTypes(assemblies.AppAssembly);
+        assemblies.LoadMillis = timer.ElapsedMillis();
+
+        timer.Reset();
+        assemblies.EntityClass = ScriptClass(assemblies.CoreAssemblyImage, "Titan", "Entity");
+        if (MonoMethod* dispatch = assemblies.EntityClass.GetMethod("DispatchCollisions", 4))
+            assemblies.DispatchCollisionsThunk = (ScriptContactThunk)mono_method_get_unmanaged_thunk(dispatch);
+        LoadAssemblyClasses(assemblies);
+        assemblies.ReflectionMillis = timer.ElapsedMillis();
+
+        return true;
     }
 
-    void ScriptEngine::LoadAppAssembly(const std::filesystem::path& filepath)
+    void ScriptEngine::ApplyAssemblies(PreparedAssemblies& assemblies)
     {
-        // Move this maybe
-        s_Data->AppAssemblyFilepath = filepath;
-        s_Data->AppAssembly = Utils::LoadMonoAssembly(filepath);
-        auto assemb = s_Data->AppAssembly;
-        s_Data->AppAssemblyImage = mono_assembly_get_image(s_Data->AppAssembly);
-        auto assembi = s_Data->AppAssemblyImage;
-        // Utils::PrintAssemblyTypes(s_Data->AppAssembly);
+        TI_PROFILE_FUNCTION();
 
-        s_Data->AppAssemblyFileWatcher =
-            CreateScope<filewatch::FileWatch<std::string>>(filepath.string(), OnAppAssemblyFileSystemEvent);
-        s_Data->AssemblyReloadPending = false;
+        Timer timer;
+
+        // Running instances live in the old domain, they are recreated from the new classes once it is swapped
+        Scene* scene = s_Data->SceneContext;
+        if (scene)
+        {
+            std::vector<entt::entity> scripted;
+            auto view = scene->GetAllEntitiesWith<ScriptInstanceComponent>();
+            for (auto [e, script] : view.each())
+            {
+                script.Instance.InvokeOnDestroy();
+                scripted.push_back(e);
+            }
+
+            ClearScriptBatches();
+            for (entt::entity e : scripted)
+                Entity{e, scene}.RemoveComponent<ScriptInstanceComponent>();
+        }
+
+        if (s_Data->AppDomain)
+        {
+            mono_domain_set(mono_get_root_domain(), false);
+            mono_domain_unload(s_Data->AppDomain);
+        }
+        mono_domain_set(assemblies.AppDomain, true);
+
+        s_Data->AppDomain = assemblies.AppDomain;
+        s_Data->CoreAssembly = assemblies.CoreAssembly;
+        s_Data->CoreAssemblyImage = assemblies.CoreAssemblyImage;
+        s_Data->AppAssembly = assemblies.AppAssembly;
+        s_Data->AppAssemblyImage = assemblies.AppAssemblyImage;
+        s_Data->CoreAssemblyFilepath = assemblies.CoreAssemblyFilepath;
+        s_Data->AppAssemblyFilepath = assemblies.AppAssemblyFilepath;
+        s_Data->EntityClass = assemblies.EntityClass;
+        s_Data->DispatchCollisionsThunk = assemblies.DispatchCollisionsThunk;
+        s_Data->EntityClasses = std::move(assemblies.EntityClasses);
+
+        ScriptGlue::RegisterComponents();
+        WatchAppAssembly();
+        const float swapMillis = timer.ElapsedMillis();
+
+        timer.Reset();
+        uint32_t recreated = 0;
+        if (scene)
+        {
+            auto view = scene->GetAllEntitiesWith<ScriptComponent>();
+            for (auto e : view)
+            {
+                Entity entity{e, scene};
+                OnCreateEntity(entity);
+                recreated += entity.HasComponent<ScriptInstanceComponent>();
+            }
+            s_Data->ScriptBatchesDirty = true;
+        }
+
+        TI_CORE_INFO("Loaded script assemblies: read in {:.2f}ms, {} classes reflected in {:.2f}ms, domain swapped in "
+                     "{:.2f}ms, {} instances recreated in {:.2f}ms",
+                     assemblies.LoadMillis, s_Data->EntityClasses.size(), assemblies.ReflectionMillis, swapMillis,
+                     recreated, timer.ElapsedMillis());
     }
 
     void ScriptEngine::ReloadAssembly()
     {
-        mono_domain_set(mono_get_root_domain(), false);
+        if (s_AotMode == ScriptAotMode::Hybrid)
+        {
+            TI_CORE_WARN("Script assemblies can't be reloaded in hybrid AOT mode");
+            return;
+        }
 
-        mono_domain_unload(s_Data->AppDomain);
+        if (s_Data->ReloadInProgress)
+        {
+            s_Data->ReloadQueued = true;
+            return;
+        }
 
-        LoadAssembly(s_Data->CoreAssemblyFilepath);
-        LoadAppAssembly(s_Data->AppAssemblyFilepath);
-        LoadAssemblyClasses();
+        s_Data->ReloadInProgress = true;
+        s_Data->AppAssemblyFileWatcher.reset();
 
-        ScriptGlue::RegisterComponents();
+        s_Data->PendingAssemblies = CreateScope<PreparedAssemblies>();
+        s_Data->PendingAssemblies->CoreAssemblyFilepath = s_Data->CoreAssemblyFilepath;
+        s_Data->PendingAssemblies->AppAssemblyFilepath = s_Data->AppAssemblyFilepath;
 
-        // Retrieve and instantiate class
-        s_Data->EntityClass = ScriptClass("Titan", "Entity", true);
+        JobSystem::Execute(
+            []()
+            {
+                // Workers are not managed threads, the attachment only lasts for this job
+                MonoThread* thread = mono_thread_attach(s_Data->RootDomain);
+                s_Data->PendingAssemblies->Loaded = PrepareAssemblies(*s_Data->PendingAssemblies);
+                mono_thread_detach(thread);
+
+                Application::GetInstance()->SubmitToMainThread([]() { FinishReload(); });
+            },
+            &s_Data->ReloadCounter);
+    }
+
+    void ScriptEngine::FinishReload()
+    {
+        // The engine shut down while the job ran
+        if (!s_Data)
+            return;
+
+        Scope<PreparedAssemblies> assemblies = std::move(s_Data->PendingAssemblies);
+        s_Data->ReloadInProgress = false;
+
+        if (assemblies->Loaded)
+        {
+            ApplyAssemblies(*assemblies);
+        }
+        else
+        {
+            // Most likely caught the assembly while it was still being written, the next write reloads again
+            TI_CORE_ERROR("Script reload failed, the previous assemblies stay loaded");
+            if (assemblies->AppDomain)
+                mono_domain_unload(assemblies->AppDomain);
+            WatchAppAssembly();
+        }
+
+        if (s_Data->ReloadQueued)
+        {
+            s_Data->ReloadQueued = false;
+            ReloadAssembly();
+        }
     }
 
     void ScriptEngine::OnRuntimeStart(Scene* scene)
     {
         s_Data->SceneContext = scene;
+        s_Data->FirstUpdatePending = true;
+        s_SceneGeneration++;
+
+        for (const auto& [name, scriptClass] : s_Data->EntityClasses)
+            scriptClass->m_TimingStats = {};
     }
 
     bool ScriptEngine::EntityClassExists(const std::string& fullClassName)
@@ -268,28 +626,216 @@ namespace Titan
         {
             UUID entityID = entity.GetUUID();
 
-            Ref<ScriptInstance> instance = CreateRef<ScriptInstance>(s_Data->EntityClasses[sc.ClassName], entity);
-            s_Data->EntityInstances[entityID] = instance;
+            Ref<ScriptClass> scriptClass = s_Data->EntityClasses[sc.ClassName];
+            ScriptCallbackScope scope(scriptClass.get(), ScriptCallbackKind::Create);
+
+            auto& component =
+                entity.AddOrReplaceComponent<ScriptInstanceComponent>(ScriptInstance(scriptClass, entity));
+            ScriptInstance& instance = component.Instance;
 
             // Copy field values
             if (s_Data->EntityScriptFields.find(entityID) != s_Data->EntityScriptFields.end())
             {
                 const ScriptFieldMap& fieldMap = s_Data->EntityScriptFields.at(entityID);
                 for (const auto& [name, fieldInstance] : fieldMap)
-                    instance->SetFieldValueInternal(name, fieldInstance.m_Buffer);
+                    instance.SetFieldValueInternal(name, fieldInstance.m_Buffer);
+            }
+
+            instance.InvokeOnCreate();
+            s_Data->ScriptBatchesDirty |= instance.GetScriptClass()->IsBatched();
+        }
+    }
+
+    void ScriptEngine::OnDestroyEntity(Entity entity)
+    {
+        if (!entity.HasComponent<ScriptInstanceComponent>())
+            return;
+
+        ScriptInstance& instance = entity.GetComponent<ScriptInstanceComponent>().Instance;
+        instance.InvokeOnDestroy();
+        s_Data->ScriptBatchesDirty |= instance.GetScriptClass()->IsBatched();
+    }
+
+    void ScriptEngine::OnUpdateScripts(Timestep ts)
+    {
+        EndTimingFrame();
+
+        Timer timer;
+
+        if (s_Data->ScriptBatchesDirty)
+            RebuildScriptBatches();
+
+        auto view = s_Data->SceneContext->GetAllEntitiesWith<ScriptInstanceComponent>();
+        {
+            ScriptUpdateRun run;
+            for (auto [e, script] : view.each())
+            {
+                ScriptClass* scriptClass = script.Instance.m_ScriptClass.get();
+                if (scriptClass->m_OnUpdateBatchThunk || !scriptClass->m_OnUpdateThunk)
+                    continue;
+
+                run.Add(scriptClass);
+                script.Instance.InvokeOnUpdate(ts);
+            }
+        }
+
+        for (const ScriptBatch& batch : s_Data->ScriptBatches)
+        {
+            if (!batch.Class->m_OnUpdateBatchThunk)
+                continue;
+
+            ScriptCallbackScope scope(batch.Class.get(), ScriptCallbackKind::Update, batch.Count);
+            MonoException* exception = nullptr;
+            batch.Class->m_OnUpdateBatchThunk((MonoArray*)mono_gchandle_get_target(batch.ArrayHandle), ts, &exception);
+            if (exception)
+                ReportException(exception);
+        }
+
+        if (s_Data->FirstUpdatePending)
+        {
+            s_Data->FirstUpdatePending = false;
+            TI_CORE_INFO("First script update took {:.2f}ms ({})", timer.ElapsedMillis(),
+                         ScriptAotModeToString(s_AotMode));
+        }
+    }
+
+    void ScriptEngine::OnFixedUpdateScripts(Timestep ts)
+    {
+        if (s_Data->ScriptBatchesDirty)
+            RebuildScriptBatches();
+
+        auto view = s_Data->SceneContext->GetAllEntitiesWith<ScriptInstanceComponent>();
+        {
+            ScriptUpdateRun run;
+            for (auto [e, script] : view.each())
+            {
+                ScriptClass* scriptClass = script.Instance.m_ScriptClass.get();
+                if (scriptClass->m_OnFixedUpdateBatchThunk || !scriptClass->m_OnFixedUpdateThunk)
+                    continue;
+
+                run.Add(scriptClass);
+                script.Instance.InvokeOnFixedUpdate(ts);
             }
+        }
 
-            instance->InvokeOnCreate();
+        for (const ScriptBatch& batch : s_Data->ScriptBatches)
+        {
+            if (!batch.Class->m_OnFixedUpdateBatchThunk)
+                continue;
+
+            ScriptCallbackScope scope(batch.Class.get(), ScriptCallbackKind::Update, batch.Count);
+            MonoException* exception = nullptr;
+            batch.Class->m_OnFixedUpdateBatchThunk((MonoArray*)mono_gchandle_get_target(batch.ArrayHandle), ts,
+                                                   &exception);
+            if (exception)
+                ReportException(exception);
         }
     }
 
-    void ScriptEngine::OnUpdateEntity(Entity entity, Timestep ts)
+    void ScriptEngine::OnContactEvents(std::span<const Scene::ContactEvent> events)
     {
-        UUID entityUUID = entity.GetUUID();
-        TI_CORE_ASSERT(s_Data->EntityInstances.find(entityUUID) != s_Data->EntityInstances.end());
+        if (!s_Data->DispatchCollisionsThunk)
+            return;
+
+        Scene* scene = s_Data->SceneContext;
+        s_Data->ContactEntities.clear();
+        s_Data->ContactOthers.clear();
+        s_Data->Contacts.clear();
+
+        auto add = [scene](entt::entity self, entt::entity other, bool began)
+        {
+            Entity entity{self, scene};
+            if (!entity.HasComponent<ScriptInstanceComponent>())
+                return;
+
+            ScriptInstance& instance = entity.GetComponent<ScriptInstanceComponent>().Instance;
+            if (!instance.GetScriptClass()->HandlesCollisions())
+                return;
+
+            // The managed side wraps others that run no script itself
+            Entity otherEntity{other, scene};
+            MonoObject* otherInstance = nullptr;
+            if (otherEntity.HasComponent<ScriptInstanceComponent>())
+                otherInstance = otherEntity.GetComponent<ScriptInstanceComponent>().Instance.GetManagedObject();
+
+            s_Data->ContactEntities.push_back(instance.GetManagedObject());
+            s_Data->ContactOthers.push_back(otherInstance);
+            s_Data->Contacts.push_back({otherEntity.GetUUID(), began});
+        };
+
+        for (const Scene::ContactEvent& event : events)
+        {
+            add(event.EntityA, event.EntityB, event.Began);
+            add(event.EntityB, event.EntityA, event.Began);
+        }
+
+        const size_t count = s_Data->Contacts.size();
+        if (!count)
+            return;
+
+        TI_PROFILE_FUNCTION();
+
+        MonoClass* entityClass = s_Data->EntityClass.m_MonoClass;
+        MonoArray* entities = mono_array_new(s_Data->AppDomain, entityClass, count);
+        MonoArray* others = mono_array_new(s_Data->AppDomain, entityClass, count);
+        for (size_t i = 0; i < count; i++)
+        {
+            mono_array_setref(entities, i, s_Data->ContactEntities[i]);
+            mono_array_setref(others, i, s_Data->ContactOthers[i]);
+        }
+
+        MonoException* exception = nullptr;
+        s_Data->DispatchCollisionsThunk(entities, others, s_Data->Contacts.data(), (int32_t)count, &exception);
+        if (exception)
+            ReportException(exception);
+    }
+
+    void ScriptEngine::RebuildScriptBatches()
+    {
+        TI_PROFILE_FUNCTION();
+
+        ClearScriptBatches();
+
+        // Grouped in pool order, so each class sees its instances in a stable order
+        std::unordered_map<ScriptClass*, size_t> batchIndices;
+        std::vector<std::vector<MonoObject*>> batchInstances;
+        auto view = s_Data->SceneContext->GetAllEntitiesWith<ScriptInstanceComponent>();
+        for (auto [e, script] : view.each())
+        {
+            Ref<ScriptClass> scriptClass = script.Instance.GetScriptClass();
+            if (!scriptClass->IsBatched())
+                continue;
+
+            auto [it, inserted] = batchIndices.try_emplace(scriptClass.get(), s_Data->ScriptBatches.size());
+            if (inserted)
+            {
+                s_Data->ScriptBatches.push_back({scriptClass});
+                batchInstances.emplace_back();
+            }
+            batchInstances[it->second].push_back(script.Instance.GetManagedObject());
+        }
+
+        for (size_t i = 0; i < s_Data->ScriptBatches.size(); i++)
+        {
+            ScriptBatch& batch = s_Data->ScriptBatches[i];
+            const std::vector<MonoObject*>& instances = batchInstances[i];
+
+            // Typed as the script class, so the managed side receives a MyScript[]
+            MonoArray* array = mono_array_new(s_Data->AppDomain, batch.Class->m_MonoClass, instances.size());
+            for (size_t j = 0; j < instances.size(); j++)
+                mono_array_setref(array, j, instances[j]);
+            batch.ArrayHandle = mono_gchandle_new((MonoObject*)array, false);
+            batch.Count = (uint32_t)instances.size();
+        }
 
-        Ref<ScriptInstance> instance = s_Data->EntityInstances[entityUUID];
-        instance->InvokeOnUpdate((float)ts);
+        s_Data->ScriptBatchesDirty = false;
+    }
+
+    void ScriptEngine::ClearScriptBatches()
+    {
+        for (const ScriptBatch& batch : s_Data->ScriptBatches)
+            mono_gchandle_free(batch.ArrayHandle);
+        s_Data->ScriptBatches.clear();
     }
 
     Scene* ScriptEngine::GetSceneContext()
@@ -297,13 +843,21 @@ namespace Titan
         return s_Data->SceneContext;
     }
 
-    Ref<ScriptInstance> ScriptEngine::GetEntityScriptInstance(UUID entityID)
+    const uint32_t* ScriptEngine::GetSceneGeneration()
     {
-        auto it = s_Data->EntityInstances.find(entityID);
-        if (it == s_Data->EntityInstances.end())
+        return &s_SceneGeneration;
+    }
+
+    ScriptInstance* ScriptEngine::GetEntityScriptInstance(UUID entityID)
+    {
+        if (!s_Data->SceneContext)
+            return nullptr;
+
+        Entity entity = s_Data->SceneContext->GetEntityByUUID(entityID);
+        if (!entity || !entity.HasComponent<ScriptInstanceComponent>())
             return nullptr;
 
-        return it->second;
+        return &entity.GetComponent<ScriptInstanceComponent>().Instance;
     }
 
     Ref<ScriptClass> ScriptEngine::GetEntityClass(const std::string& name)
@@ -316,9 +870,17 @@ namespace Titan
 
     void ScriptEngine::OnRuntimeStop()
     {
-        s_Data->SceneContext = nullptr;
+        auto view = s_Data->SceneContext->GetAllEntitiesWith<ScriptInstanceComponent>();
+        for (auto [e, script] : view.each())
+            script.Instance.InvokeOnDestroy();
+
+        EndTimingFrame();
+        LogClassTimings();
 
-        s_Data->EntityInstances.clear();
+        ClearScriptBatches();
+        s_Data->ScriptBatchesDirty = false;
+        s_Data->SceneContext = nullptr;
+        s_SceneGeneration++;
     }
 
     std::unordered_map<std::string, Ref<ScriptClass>> ScriptEngine::GetEntityClasses()
@@ -334,29 +896,27 @@ namespace Titan
         return s_Data->EntityScriptFields[entityID];
     }
 
-    void ScriptEngine::LoadAssemblyClasses()
+    void ScriptEngine::LoadAssemblyClasses(PreparedAssemblies& assemblies)
     {
-        s_Data->EntityClasses.clear();
-
-        const MonoTableInfo* typeDefinitionsTable =
-            mono_image_get_table_info(s_Data->AppAssemblyImage, MONO_TABLE_TYPEDEF);
+        MonoImage* appImage = assemblies.AppAssemblyImage;
+        const MonoTableInfo* typeDefinitionsTable = mono_image_get_table_info(appImage, MONO_TABLE_TYPEDEF);
         int32_t numTypes = mono_table_info_get_rows(typeDefinitionsTable);
-        MonoClass* entityClass = mono_class_from_name(s_Data->CoreAssemblyImage, "Titan", "Entity");
+        MonoClass* entityClass = mono_class_from_name(assemblies.CoreAssemblyImage, "Titan", "Entity");
 
         for (int32_t i = 0; i < numTypes; i++)
         {
             uint32_t cols[MONO_TYPEDEF_SIZE];
             mono_metadata_decode_row(typeDefinitionsTable, i, cols, MONO_TYPEDEF_SIZE);
 
-            const char* nameSpace = mono_metadata_string_heap(s_Data->AppAssemblyImage, cols[MONO_TYPEDEF_NAMESPACE]);
-            const char* className = mono_metadata_string_heap(s_Data->AppAssemblyImage, cols[MONO_TYPEDEF_NAME]);
+            const char* nameSpace = mono_metadata_string_heap(appImage, cols[MONO_TYPEDEF_NAMESPACE]);
+            const char* className = mono_metadata_string_heap(appImage, cols[MONO_TYPEDEF_NAME]);
             std::string fullName;
             if (strlen(nameSpace) != 0)
                 fullName = fmt::format("{}.{}", nameSpace, className);
             else
                 fullName = className;
 
-            MonoClass* monoClass = mono_class_from_name(s_Data->AppAssemblyImage, nameSpace, className);
+            MonoClass* monoClass = mono_class_from_name(appImage, nameSpace, className);
 
             if (monoClass == entityClass)
                 continue;
@@ -365,8 +925,8 @@ namespace Titan
             if (!isEntity)
                 continue;
 
-            Ref<ScriptClass> scriptClass = CreateRef<ScriptClass>(nameSpace, className);
-            s_Data->EntityClasses[fullName] = scriptClass;
+            Ref<ScriptClass> scriptClass = CreateRef<ScriptClass>(appImage, nameSpace, className);
+            assemblies.EntityClasses[fullName] = scriptClass;
 
             // This routine is an iterator routine for retrieving the fields in a class.
             // You must pass a gpointer that points to zero and is treated as an opaque handle
@@ -389,10 +949,6 @@ namespace Titan
                 }
             }
         }
-
-        auto& entityClasses = s_Data->EntityClasses;
-
-        // mono_field_get_value()
     }
 
     MonoImage* ScriptEngine::GetCoreAssemblyImage()
@@ -402,8 +958,106 @@ namespace Titan
 
     MonoObject* ScriptEngine::GetManagedInstance(UUID uuid)
     {
-        TI_CORE_ASSERT(s_Data->EntityInstances.find(uuid) != s_Data->EntityInstances.end());
-        return s_Data->EntityInstances.at(uuid)->GetManagedObject();
+        ScriptInstance* instance = GetEntityScriptInstance(uuid);
+        TI_CORE_ASSERT(instance);
+        return instance->GetManagedObject();
+    }
+
+    ScriptEngine::Statistics ScriptEngine::GetStats()
+    {
+        Statistics stats;
+        stats.Total.AllocatedBytes = s_Data->AllocatedBytes;
+        stats.Total.Allocations = s_Data->Allocations;
+        stats.Total.GCCount = s_Data->GCCount;
+        stats.Total.GCMillis = s_Data->GCMicros / 1000.0f;
+
+        for (const auto& [name, scriptClass] : s_Data->EntityClasses)
+        {
+            const ScriptAllocationStats& classStats = scriptClass->m_AllocationStats;
+            if (classStats.Allocations || classStats.GCCount)
+                stats.Classes.emplace_back(name, classStats);
+        }
+        std::sort(stats.Classes.begin(), stats.Classes.end(),
+                  [](const auto& a, const auto& b) { return a.second.AllocatedBytes > b.second.AllocatedBytes; });
+
+        return stats;
+    }
+
+    void ScriptEngine::ResetStats()
+    {
+        s_Data->AllocatedBytes = 0;
+        s_Data->Allocations = 0;
+        s_Data->GCCount = 0;
+        s_Data->GCMicros = 0;
+
+        for (const auto& [name, scriptClass] : s_Data->EntityClasses)
+            scriptClass->m_AllocationStats = {};
+    }
+
+    void ScriptEngine::EndTimingFrame()
+    {
+        for (const auto& [name, scriptClass] : s_Data->EntityClasses)
+        {
+            ScriptTimingStats& timing = scriptClass->m_TimingStats;
+            if (!timing.FrameTicks)
+                continue;
+
+            timing.FrameMillis[timing.FrameCount % ScriptTimingStats::WindowSize] = TicksToMillis(timing.FrameTicks);
+            timing.FrameCount++;
+            timing.FrameTicks = 0;
+        }
+    }
+
+    std::vector<ScriptEngine::ClassTiming> ScriptEngine::GetClassTimings()
+    {
+        std::vector<ClassTiming> timings;
+        for (const auto& [name, scriptClass] : s_Data->EntityClasses)
+        {
+            const ScriptTimingStats& stats = scriptClass->m_TimingStats;
+            if (!stats.CreateCalls && !stats.UpdateCalls)
+                continue;
+
+            ClassTiming& timing = timings.emplace_back();
+            timing.Name = name;
+            timing.CreateCalls = stats.CreateCalls;
+            timing.CreateMillis = TicksToMillis(stats.CreateTicks);
+            timing.UpdateCalls = stats.UpdateCalls;
+            timing.UpdateMillis = TicksToMillis(stats.UpdateTicks);
+
+            const uint32_t frames = (std::min)(stats.FrameCount, ScriptTimingStats::WindowSize);
+            if (!frames)
+                continue;
+
+            timing.MinFrameMillis = std::numeric_limits<float>::max();
+            for (uint32_t i = 0; i < frames; i++)
+            {
+                const float millis = stats.FrameMillis[i];
+                timing.MinFrameMillis = (std::min)(timing.MinFrameMillis, millis);
+                timing.MaxFrameMillis = (std::max)(timing.MaxFrameMillis, millis);
+                timing.AvgFrameMillis += millis;
+            }
+            timing.AvgFrameMillis /= frames;
+        }
+
+        std::sort(timings.begin(), timings.end(),
+                  [](const ClassTiming& a, const ClassTiming& b) { return a.AvgFrameMillis > b.AvgFrameMillis; });
+        return timings;
+    }
+
+    void ScriptEngine::LogClassTimings()
+    {
+        const std::vector<ClassTiming> timings = GetClassTimings();
+        if (timings.empty())
+            return;
+
+        TI_CORE_INFO("Script classes by update time per frame (last {} frames):", ScriptTimingStats::WindowSize);
+        for (const ClassTiming& timing : timings)
+        {
+            TI_CORE_INFO("  {:<32} avg {:.3f}ms min {:.3f}ms max {:.3f}ms | update {} calls {:.2f}ms | create {} calls "
+                         "{:.2f}ms",
+                         timing.Name, timing.AvgFrameMillis, timing.MinFrameMillis, timing.MaxFrameMillis,
+                         timing.UpdateCalls, timing.UpdateMillis, timing.CreateCalls, timing.CreateMillis);
+        }
     }
 
     MonoObject* ScriptEngine::InstantiateClass(MonoClass* monoClass)
@@ -414,10 +1068,38 @@ namespace Titan
     }
 
     ScriptClass::ScriptClass(const std::string& classNamespace, const std::string& className, bool isCore)
+        : ScriptClass(isCore ? s_Data->CoreAssemblyImage : s_Data->AppAssemblyImage, classNamespace, className)
+    {
+    }
+
+    ScriptClass::ScriptClass(MonoImage* image, const std::string& classNamespace, const std::string& className)
         : m_ClassNamespace(classNamespace), m_ClassName(className)
     {
-        m_MonoClass = mono_class_from_name(isCore ? s_Data->CoreAssemblyImage : s_Data->AppAssemblyImage,
-                                           classNamespace.c_str(), className.c_str());
+        m_MonoClass = mono_class_from_name(image, classNamespace.c_str(), className.c_str());
+        ResolveCallbacks();
+    }
+
+    void ScriptClass::ResolveCallbacks()
+    {
+        if (!m_MonoClass)
+            return;
+
+        // Thunks skip the argument boxing and method lookup of mono_runtime_invoke on every call
+        auto resolve = [this](const char* name, int parameterCount) -> void*
+        {
+            MonoMethod* method = GetMethod(name, parameterCount);
+            return method ? mono_method_get_unmanaged_thunk(method) : nullptr;
+        };
+
+        m_OnCreateThunk = (ScriptCallbackThunk)resolve("OnCreate", 0);
+        m_OnUpdateThunk = (ScriptUpdateThunk)resolve("OnUpdate", 1);
+        m_OnFixedUpdateThunk = (ScriptUpdateThunk)resolve("OnFixedUpdate", 1);
+        m_OnDestroyThunk = (ScriptCallbackThunk)resolve("OnDestroy", 0);
+        m_OnUpdateBatchThunk = (ScriptBatchThunk)resolve("OnUpdateBatch", 2);
+        m_OnFixedUpdateBatchThunk = (ScriptBatchThunk)resolve("OnFixedUpdateBatch", 2);
+
+        // Called through Entity.DispatchCollisions, only whether the class overrides them matters
+        m_HandlesCollisions = GetMethod("OnCollisionEnter", 1) || GetMethod("OnCollisionExit", 1);
     }
 
     MonoObject* ScriptClass::Instantiate()
@@ -440,8 +1122,6 @@ namespace Titan
         m_Instance = scriptClass->Instantiate();
 
         m_Constructor = s_Data->EntityClass.GetMethod(".ctor", 1);
-        m_OnCreateMethod = scriptClass->GetMethod("OnCreate", 0);
-        m_OnUpdateMethod = scriptClass->GetMethod("OnUpdate", 1);
 
         // Call Entity constructor
         {
@@ -453,17 +1133,48 @@ namespace Titan
 
     void ScriptInstance::InvokeOnCreate()
     {
-        if (m_OnCreateMethod)
-            m_ScriptClass->InvokeMethod(m_Instance, m_OnCreateMethod);
+        if (!m_ScriptClass->m_OnCreateThunk)
+            return;
+
+        // Timed by the scope in ScriptEngine::OnCreateEntity, which also covers constructing the instance
+        MonoException* exception = nullptr;
+        m_ScriptClass->m_OnCreateThunk(m_Instance, &exception);
+        if (exception)
+            ReportException(exception);
     }
 
     void ScriptInstance::InvokeOnUpdate(float ts)
     {
-        if (m_OnUpdateMethod)
-        {
-            void* param = &ts;
-            m_ScriptClass->InvokeMethod(m_Instance, m_OnUpdateMethod, &param);
-        }
+        if (!m_ScriptClass->m_OnUpdateThunk)
+            return;
+
+        MonoException* exception = nullptr;
+        m_ScriptClass->m_OnUpdateThunk(m_Instance, ts, &exception);
+        if (exception)
+            ReportException(exception);
+    }
+
+    void ScriptInstance::InvokeOnFixedUpdate(float ts)
+    {
+        if (!m_ScriptClass->m_OnFixedUpdateThunk)
+            return;
+
+        MonoException* exception = nullptr;
+        m_ScriptClass->m_OnFixedUpdateThunk(m_Instance, ts, &exception);
+        if (exception)
+            ReportException(exception);
+    }
+
+    void ScriptInstance::InvokeOnDestroy()
+    {
+        if (!m_ScriptClass->m_OnDestroyThunk)
+            return;
+
+        ScriptCallbackScope scope(m_ScriptClass.get(), ScriptCallbackKind::Destroy);
+        MonoException* exception = nullptr;
+        m_ScriptClass->m_OnDestroyThunk(m_Instance, &exception);
+        if (exception)
+            ReportException(exception);
     }
 
     bool ScriptInstance::GetFieldValueInternal(const std::string& name, void* buffer)
@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <map>
+#include <span>
 #include <string>
 
 extern "C"
@@ -15,8 +16,17 @@ extern "C"
     typedef struct _MonoAssembly MonoAssembly;
     typedef struct _MonoImage MonoImage;
     typedef struct _MonoClassField MonoClassField;
+    typedef struct _MonoException MonoException;
+    typedef struct _MonoArray MonoArray;
 }
 
+// Calling convention of the pointers returned by mono_method_get_unmanaged_thunk
+#ifdef TI_PLATFORM_WINDOWS
+    #define TI_MONO_THUNK __stdcall
+#else
+    #define TI_MONO_THUNK
+#endif
+
 namespace Titan
 {
 
@@ -49,11 +59,49 @@ namespace Titan
         MonoClassField* ClassField;
     };
 
+    // Entity callbacks called as plain function pointers, exceptions come back through the last parameter
+    using ScriptCallbackThunk = void(TI_MONO_THUNK*)(MonoObject* instance, MonoException** exception);
+    using ScriptUpdateThunk = void(TI_MONO_THUNK*)(MonoObject* instance, float ts, MonoException** exception);
+    // Static per class update, called with an array of every instance of the class
+    using ScriptBatchThunk = void(TI_MONO_THUNK*)(MonoArray* instances, float ts, MonoException** exception);
+    // Entity.DispatchCollisions, every contact of a physics step for the scripts that handle collisions
+    using ScriptContactThunk = void(TI_MONO_THUNK*)(MonoArray* entities, MonoArray* others, const void* contacts,
+                                                    int32_t count, MonoException** exception);
+
+    // Managed allocations and garbage collections, gathered through the Mono profiler in builds with
+    // TI_ENABLE_SCRIPT_PROFILING. They accumulate until ScriptEngine::ResetStats.
+    struct ScriptAllocationStats
+    {
+        uint64_t AllocatedBytes = 0;
+        uint32_t Allocations = 0;
+        uint32_t GCCount = 0;
+        float GCMillis = 0.0f;
+    };
+
+    // CPU time spent in a class's callbacks, reset when the runtime starts. Update covers OnUpdate, OnFixedUpdate
+    // and the batch calls, where every batched instance counts as one call.
+    struct ScriptTimingStats
+    {
+        static constexpr uint32_t WindowSize = 120;
+
+        uint64_t CreateCalls = 0;
+        uint64_t CreateTicks = 0;
+        uint64_t UpdateCalls = 0;
+        uint64_t UpdateTicks = 0;
+
+        uint64_t FrameTicks = 0;
+        // Update time of the last WindowSize frames the class ran in, as a ring
+        std::array<float, WindowSize> FrameMillis{};
+        uint32_t FrameCount = 0;
+    };
+
     class ScriptClass
     {
     public:
         ScriptClass() = default;
         ScriptClass(const std::string& classNamespace, const std::string& className, bool isCore = false);
+        // Looks the class up in the given image, the callbacks are resolved for the calling thread's domain
+        ScriptClass(MonoImage* image, const std::string& classNamespace, const std::string& className);
 
         MonoObject* Instantiate();
         MonoMethod* GetMethod(const std::string& name, int parameterCount);
@@ -61,6 +109,16 @@ namespace Titan
 
         const std::map<std::string, ScriptField>& GetFields() const { return m_Fields; }
 
+        // Classes with a static OnUpdateBatch or OnFixedUpdateBatch get one call per frame for all their instances
+        // in place of the per instance callback
+        bool IsBatched() const { return m_OnUpdateBatchThunk || m_OnFixedUpdateBatchThunk; }
+        // Overrides OnCollisionEnter or OnCollisionExit, only these classes get contact events
+        bool HandlesCollisions() const { return m_HandlesCollisions; }
+
+    private:
+        // Resolved once per class, null for callbacks the class does not define
+        void ResolveCallbacks();
+
     private:
         std::string m_ClassNamespace;
         std::string m_ClassName;
@@ -69,7 +127,22 @@ namespace Titan
 
         MonoClass* m_MonoClass = nullptr;
 
+        ScriptCallbackThunk m_OnCreateThunk = nullptr;
+        ScriptUpdateThunk m_OnUpdateThunk = nullptr;
+        ScriptUpdateThunk m_OnFixedUpdateThunk = nullptr;
+        ScriptCallbackThunk m_OnDestroyThunk = nullptr;
+        ScriptBatchThunk m_OnUpdateBatchThunk = nullptr;
+        ScriptBatchThunk m_OnFixedUpdateBatchThunk = nullptr;
+        bool m_HandlesCollisions = false;
+
+        // While this class's callbacks ran
+        ScriptAllocationStats m_AllocationStats;
+        ScriptTimingStats m_TimingStats;
+
         friend class ScriptEngine;
+        friend class ScriptInstance;
+        friend struct ScriptCallbackScope;
+        friend struct ScriptUpdateRun;
     };
 
     struct ScriptFieldInstance
@@ -107,7 +180,10 @@ namespace Titan
         ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity);
 
         void InvokeOnCreate();
+        // Not timed themselves, ScriptEngine times the calls of a frame per run of instances of one class
         void InvokeOnUpdate(float ts);
+        void InvokeOnFixedUpdate(float ts);
+        void InvokeOnDestroy();
 
         Ref<ScriptClass> GetScriptClass() { return m_ScriptClass; }
 
@@ -142,8 +218,6 @@ namespace Titan
 
         MonoObject* m_Instance = nullptr;
         MonoMethod* m_Constructor = nullptr;
-        MonoMethod* m_OnCreateMethod = nullptr;
-        MonoMethod* m_OnUpdateMethod = nullptr;
 
         inline static char s_FieldValueBuffer[16];
 
@@ -151,15 +225,35 @@ namespace Titan
         friend struct ScriptFieldInstance;
     };
 
+    // Runtime only, added by ScriptEngine::OnCreateEntity for entities whose script class exists and removed when
+    // the runtime stops. The instances live in the component pool, so updates walk them in order without a lookup.
+    struct ScriptInstanceComponent
+    {
+        ScriptInstance Instance;
+    };
+
+    // How Mono uses precompiled images of the script assemblies, built with the TI_SCRIPT_AOT CMake option
+    enum class ScriptAotMode
+    {
+        None,   // Everything is JIT compiled on first call
+        Normal, // AOT code where an up to date image exists, the JIT covers the rest
+        Hybrid  // Method bodies must be precompiled, the JIT only generates wrappers. No hot reload.
+    };
+
+    struct PreparedAssemblies;
+
     class ScriptEngine
     {
     public:
+        // Runtime builds only, the editor relies on the JIT for hot reload. Has to be set before Init.
+        static void SetAotMode(ScriptAotMode mode);
+
         static void Init();
         static void Shutdown();
 
-        static void LoadAssembly(const std::filesystem::path& filepath);
-        static void LoadAppAssembly(const std::filesystem::path& filepath);
-
+        // Loads both assemblies into a new domain on a worker while the current one keeps running. The main thread
+        // only swaps the domains and recreates running script instances, through Application::SubmitToMainThread.
+        // A reload requested while one is under way runs once it is done.
         static void ReloadAssembly();
 
         static void OnRuntimeStart(Scene* scene);
@@ -167,10 +261,20 @@ namespace Titan
 
         static bool EntityClassExists(const std::string& fullClassName);
         static void OnCreateEntity(Entity entity);
-        static void OnUpdateEntity(Entity entity, Timestep ts);
+        static void OnDestroyEntity(Entity entity);
+
+        // Every running script of the scene context, instances of batched classes in one call per class
+        static void OnUpdateScripts(Timestep ts);
+        static void OnFixedUpdateScripts(Timestep ts);
+        // Passes the contacts of one physics step to OnCollisionEnter and OnCollisionExit in a single managed call
+        static void OnContactEvents(std::span<const Scene::ContactEvent> events);
 
         static Scene* GetSceneContext();
-        static Ref<ScriptInstance> GetEntityScriptInstance(UUID entityID);
+        // Bumped whenever a runtime scene starts or stops. Managed entities drop the handle and transform pointer they
+        // cached under another generation, since the scene those belong to may be gone.
+        static const uint32_t* GetSceneGeneration();
+        // Null if the entity has no running script
+        static ScriptInstance* GetEntityScriptInstance(UUID entityID);
 
         static Ref<ScriptClass> GetEntityClass(const std::string& name);
         static std::unordered_map<std::string, Ref<ScriptClass>> GetEntityClasses();
@@ -180,12 +284,49 @@ namespace Titan
 
         static MonoObject* GetManagedInstance(UUID uuid);
 
+        struct Statistics
+        {
+            ScriptAllocationStats Total;
+            // Classes that allocated or triggered a collection, by full name, most bytes first
+            std::vector<std::pair<std::string, ScriptAllocationStats>> Classes;
+        };
+        static Statistics GetStats();
+        static void ResetStats();
+
+        struct ClassTiming
+        {
+            std::string Name;
+            uint64_t CreateCalls = 0;
+            float CreateMillis = 0.0f;
+            uint64_t UpdateCalls = 0;
+            float UpdateMillis = 0.0f;
+            // Update time per frame over the last ScriptTimingStats::WindowSize frames
+            float MinFrameMillis = 0.0f;
+            float AvgFrameMillis = 0.0f;
+            float MaxFrameMillis = 0.0f;
+        };
+        // Classes that ran since the runtime started, most expensive per frame first
+        static std::vector<ClassTiming> GetClassTimings();
+
     private:
         static void InitMono();
         static void ShutdownMono();
 
         static MonoObject* InstantiateClass(MonoClass* monoClass);
-        static void LoadAssemblyClasses();
+
+        // Creates a domain and loads the assemblies into it, safe to call from any thread attached to Mono
+        static bool PrepareAssemblies(PreparedAssemblies& assemblies);
+        static void LoadAssemblyClasses(PreparedAssemblies& assemblies);
+        // Main thread only, replaces the current domain with the prepared one
+        static void ApplyAssemblies(PreparedAssemblies& assemblies);
+        static void FinishReload();
+
+        static void RebuildScriptBatches();
+        static void ClearScriptBatches();
+
+        // Moves the update time of the frame that just ended into the rolling windows
+        static void EndTimingFrame();
+        static void LogClassTimings();
 
         friend class ScriptClass;
         friend class ScriptGlue;
@@ -8,6 +8,7 @@
 #include "Titan/Scene/Entity.h"
 #include "Titan/Scene/Scene.h"
 #include "box2d/b2_body.h"
+#include "mono/metadata/appdomain.h"
 #include "mono/metadata/object.h"
 #include "mono/metadata/reflection.h"
 
@@ -103,12 +104,42 @@ namespace Titan
         return ScriptEngine::GetManagedInstance(entityID);
     }
 
-    static bool Entity_HasComponent(UUID entityID, MonoReflectionType* componentType)
+    // Scripts cache the entt handle of their entity, so resolving it is a sparse set lookup instead of a UUID hash.
+    // The cached handle may outlive its entity, so a destroyed or recycled one resolves to a null Entity.
+    static Entity GetEntityFromHandle(uint32_t handle)
+    {
+        Scene* scene = ScriptEngine::GetSceneContext();
+        TI_CORE_ASSERT(scene);
+        Entity entity{(entt::entity)handle, scene};
+        if (!entity.IsValid())
+        {
+            TI_CORE_ERROR("Script used entity handle {:#x}, which no longer exists", handle);
+            return {};
+        }
+        return entity;
+    }
+
+    static const uint32_t* Scene_GetGeneration()
+    {
+        return ScriptEngine::GetSceneGeneration();
+    }
+
+    static uint32_t Entity_GetHandle(UUID entityID)
     {
         Scene* scene = ScriptEngine::GetSceneContext();
         TI_CORE_ASSERT(scene);
         Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
+        if (!entity)
+            TI_CORE_ERROR("Script used entity {}, which no longer exists", (uint64_t)entityID);
+
+        return (uint32_t)entity;
+    }
+
+    static bool Entity_HasComponent(uint32_t handle, MonoReflectionType* componentType)
+    {
+        Entity entity = GetEntityFromHandle(handle);
+        if (!entity)
+            return false;
 
         MonoType* managedType = mono_reflection_type_get_type(componentType);
         TI_CORE_ASSERT(s_EntityHasComponentFuncs.find(managedType) != s_EntityHasComponentFuncs.end());
@@ -130,87 +161,65 @@ namespace Titan
         return entity.GetUUID();
     }
 
-    static void TransformComponent_GetTranslation(UUID entityID, glm::vec3* outTranslation)
-    {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
-
-        *outTranslation = entity.GetComponent<TransformComponent>().Translation;
-    }
-
-    static void TransformComponent_SetTranslation(UUID entityID, glm::vec3* translation)
-    {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
-
-        entity.GetComponent<TransformComponent>().Translation = *translation;
-    }
-
-    static void TransformComponent_GetRotation(UUID entityID, glm::vec3* outRotation)
+    static MonoArray* Entity_FindEntitiesByName(MonoString* name)
     {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
-
-        *outRotation = entity.GetComponent<TransformComponent>().Rotation;
-    }
+        char* nameCStr = mono_string_to_utf8(name);
 
-    static void TransformComponent_SetRotation(UUID entityID, glm::vec3* rotation)
-    {
         Scene* scene = ScriptEngine::GetSceneContext();
         TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
+        std::vector<entt::entity> entities;
+        scene->FindEntitiesByName(nameCStr, entities);
+        mono_free(nameCStr);
 
-        entity.GetComponent<TransformComponent>().Rotation = *rotation;
+        MonoArray* ids = mono_array_new(mono_domain_get(), mono_get_uint64_class(), entities.size());
+        for (size_t i = 0; i < entities.size(); i++)
+            mono_array_set(ids, uint64_t, i, (uint64_t)Entity(entities[i], scene).GetUUID());
+        return ids;
     }
 
-    static void TransformComponent_GetScale(UUID entityID, glm::vec3* outScale)
-    {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
-
-        *outScale = entity.GetComponent<TransformComponent>().Scale;
-    }
+    // The managed TransformData mirrors this layout
+    static_assert(sizeof(TransformComponent) == 9 * sizeof(float));
+    static_assert(offsetof(TransformComponent, Rotation) == 3 * sizeof(float));
+    static_assert(offsetof(TransformComponent, Scale) == 6 * sizeof(float));
 
-    static void TransformComponent_SetScale(UUID entityID, glm::vec3* scale)
+    // Scripts read and write the component through the returned pointer until the version changes.
+    // Null if the entity no longer exists.
+    static TransformComponent* TransformComponent_GetData(uint32_t handle, const uint32_t** outVersion)
     {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
+        Entity entity = GetEntityFromHandle(handle);
+        *outVersion = ScriptEngine::GetSceneContext()->GetTransformStorageVersion();
+        if (!entity)
+            return nullptr;
 
-        entity.GetComponent<TransformComponent>().Scale = *scale;
+        return &entity.GetComponent<TransformComponent>();
     }
 
-    static void Rigidbody2DComponent_ApplyLinearImpulse(UUID entityID, glm::vec2* impulse, glm::vec2* point, bool wake)
+    static void Rigidbody2DComponent_ApplyLinearImpulse(uint32_t handle, glm::vec2* impulse, glm::vec2* point,
+                                                        bool wake)
     {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
+        Entity entity = GetEntityFromHandle(handle);
+        if (!entity || !entity.HasComponent<Rigidbody2DComponent>())
+            return;
 
         auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
         b2Body* body = (b2Body*)rb2d.RuntimeBody;
+        if (!body)
+            return;
+
         body->ApplyLinearImpulse(b2Vec2(impulse->x, impulse->y), b2Vec2(point->x, point->y), wake);
     }
 
-    static void Rigidbody2DComponent_ApplyLinearImpulseToCenter(UUID entityID, glm::vec2* impulse, bool wake)
+    static void Rigidbody2DComponent_ApplyLinearImpulseToCenter(uint32_t handle, glm::vec2* impulse, bool wake)
     {
-        Scene* scene = ScriptEngine::GetSceneContext();
-        TI_CORE_ASSERT(scene);
-        Entity entity = scene->GetEntityByUUID(entityID);
-        TI_CORE_ASSERT(entity);
+        Entity entity = GetEntityFromHandle(handle);
+        if (!entity || !entity.HasComponent<Rigidbody2DComponent>())
+            return;
 
         auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
         b2Body* body = (b2Body*)rb2d.RuntimeBody;
+        if (!body)
+            return;
+
         body->ApplyLinearImpulseToCenter(b2Vec2(impulse->x, impulse->y), wake);
     }
 
@@ -270,15 +279,14 @@ namespace Titan
 
         TI_ADD_INTERNAL_CALL(GetScriptInstance);
 
+        TI_ADD_INTERNAL_CALL(Scene_GetGeneration);
+
+        TI_ADD_INTERNAL_CALL(Entity_GetHandle);
         TI_ADD_INTERNAL_CALL(Entity_HasComponent);
         TI_ADD_INTERNAL_CALL(Entity_FindEntityByName);
+        TI_ADD_INTERNAL_CALL(Entity_FindEntitiesByName);
 
-        TI_ADD_INTERNAL_CALL(TransformComponent_GetTranslation);
-        TI_ADD_INTERNAL_CALL(TransformComponent_SetTranslation);
-        TI_ADD_INTERNAL_CALL(TransformComponent_GetRotation);
-        TI_ADD_INTERNAL_CALL(TransformComponent_SetRotation);
-        TI_ADD_INTERNAL_CALL(TransformComponent_GetScale);
-        TI_ADD_INTERNAL_CALL(TransformComponent_SetScale);
+        TI_ADD_INTERNAL_CALL(TransformComponent_GetData);
 
         TI_ADD_INTERNAL_CALL(Rigidbody2DComponent_ApplyLinearImpulse);
         TI_ADD_INTERNAL_CALL(Rigidbody2DComponent_ApplyLinearImpulseToCenter);
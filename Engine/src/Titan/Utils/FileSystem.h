@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    // Read-only memory mapping of a whole file. The mapping stays valid for the lifetime of the object.
+    class TI_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool IsValid() const { return m_Data != nullptr; }
+        const uint8_t* GetData() const { return m_Data; }
+        uint64_t GetSize() const { return m_Size; }
+
+        void Close();
+
+    private:
+        const uint8_t* m_Data = nullptr;
+        uint64_t m_Size = 0;
+
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+    };
+
+} // namespace Titan
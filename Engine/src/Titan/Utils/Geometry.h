@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Titan/PCH.h"
+
+namespace Titan
+{
+
+    struct AABB
+    {
+        glm::vec3 Min{0.0f};
+        glm::vec3 Max{0.0f};
+
+        AABB() = default;
+        AABB(const glm::vec3& min, const glm::vec3& max) : Min(min), Max(max) {}
+
+        glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+        glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+        // Surface area, the cost measure of the BVH
+        float GetArea() const
+        {
+            const glm::vec3 d = Max - Min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        bool Contains(const AABB& other) const
+        {
+            return glm::all(glm::lessThanEqual(Min, other.Min)) && glm::all(glm::greaterThanEqual(Max, other.Max));
+        }
+
+        bool Overlaps(const AABB& other) const
+        {
+            return glm::all(glm::lessThanEqual(Min, other.Max)) && glm::all(glm::greaterThanEqual(Max, other.Min));
+        }
+
+        bool OverlapsSphere(const glm::vec3& center, float radius) const
+        {
+            const glm::vec3 closest = glm::clamp(center, Min, Max);
+            const glm::vec3 d = closest - center;
+            return glm::dot(d, d) <= radius * radius;
+        }
+
+        AABB Expanded(float margin) const { return {Min - glm::vec3(margin), Max + glm::vec3(margin)}; }
+
+        // Bounds of the transformed box (Arvo), exact for the box but not for what it encloses
+        AABB Transformed(const glm::mat4& transform) const
+        {
+            const glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+            const glm::vec3 extents = GetExtents();
+            const glm::mat3 absolute = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])),
+                                                 glm::abs(glm::vec3(transform[2])));
+            const glm::vec3 worldExtents = absolute * extents;
+            return {center - worldExtents, center + worldExtents};
+        }
+
+        static AABB Union(const AABB& a, const AABB& b) { return {glm::min(a.Min, b.Min), glm::max(a.Max, b.Max)}; }
+    };
+
+    struct Ray
+    {
+        glm::vec3 Origin{0.0f};
+        glm::vec3 Direction{0.0f, 0.0f, -1.0f};
+
+        // Slab test, the distance along the ray where it enters the box or a negative value on a miss.
+        // Starts inside the box count as hits at 0.
+        float Intersect(const AABB& box, float maxDistance) const
+        {
+            const glm::vec3 inverse = 1.0f / Direction;
+            const glm::vec3 t0 = (box.Min - Origin) * inverse;
+            const glm::vec3 t1 = (box.Max - Origin) * inverse;
+            const glm::vec3 tMin = glm::min(t0, t1);
+            const glm::vec3 tMax = glm::max(t0, t1);
+
+            const float enter = (std::max)((std::max)(tMin.x, tMin.y), (std::max)(tMin.z, 0.0f));
+            const float exit = (std::min)((std::min)(tMax.x, tMax.y), (std::min)(tMax.z, maxDistance));
+            return enter <= exit ? enter : -1.0f;
+        }
+    };
+
+    // Six inward facing planes, xyz the normal and w the distance
+    struct Frustum
+    {
+        std::array<glm::vec4, 6> Planes;
+
+        // Gribb/Hartmann plane extraction for an OpenGL clip space (-1 to 1 depth)
+        static Frustum FromViewProjection(const glm::mat4& viewProjection)
+        {
+            const glm::mat4 m = glm::transpose(viewProjection);
+            Frustum frustum;
+            frustum.Planes[0] = m[3] + m[0]; // Left
+            frustum.Planes[1] = m[3] - m[0]; // Right
+            frustum.Planes[2] = m[3] + m[1]; // Bottom
+            frustum.Planes[3] = m[3] - m[1]; // Top
+            frustum.Planes[4] = m[3] + m[2]; // Near
+            frustum.Planes[5] = m[3] - m[2]; // Far
+
+            for (glm::vec4& plane : frustum.Planes)
+                plane /= glm::length(glm::vec3(plane));
+
+            return frustum;
+        }
+
+        // Conservative, boxes near a corner outside two planes may still pass
+        bool Overlaps(const AABB& box) const
+        {
+            for (const glm::vec4& plane : Planes)
+            {
+                // The corner furthest along the plane normal
+                const glm::vec3 normal = glm::vec3(plane);
+                const glm::vec3 positive = glm::mix(box.Min, box.Max, glm::greaterThanEqual(normal, glm::vec3(0.0f)));
+                if (glm::dot(normal, positive) + plane.w < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+    };
+
+} // namespace Titan
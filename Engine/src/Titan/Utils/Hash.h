@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Titan/PCH.h"
+
+namespace Titan::Hash
+{
+
+    constexpr uint64_t FNV1aOffsetBasis = 0xcbf29ce484222325ull;
+    constexpr uint64_t FNV1aPrime = 0x100000001b3ull;
+
+    // 64-bit FNV-1a, stable across runs and platforms (used for on-disk cache keys)
+    inline uint64_t FNV1a(const void* data, size_t size, uint64_t seed = FNV1aOffsetBasis)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= FNV1aPrime;
+        }
+        return hash;
+    }
+
+    inline uint64_t FNV1a(std::string_view str, uint64_t seed = FNV1aOffsetBasis)
+    {
+        return FNV1a(str.data(), str.size(), seed);
+    }
+
+    inline uint64_t Combine(uint64_t hash, uint64_t value)
+    {
+        return FNV1a(&value, sizeof(value), hash);
+    }
+
+} // namespace Titan::Hash
@@ -0,0 +1,12 @@
+using Titan;
+
+namespace Sandbox
+{
+    // Does nothing, spawned in bulk by the server (--spawn 10000 Sandbox.Idle) to time script dispatch alone
+    public class Idle : Entity
+    {
+        void OnCreate() {}
+
+        void OnUpdate(float ts) {}
+    }
+}
@@ -36,38 +36,32 @@ namespace Titan
         internal extern static void InternalClientLogCritical(string message);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static bool Entity_HasComponent(ulong entityID, Type componentType);
+        internal extern static unsafe uint* Scene_GetGeneration();
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static ulong Entity_FindEntityByName(string name);
-
-        [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static object GetScriptInstance(ulong entityID);
+        internal extern static uint Entity_GetHandle(ulong entityID);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_GetTranslation(ulong entityID, out Vector3 translation);
+        internal extern static bool Entity_HasComponent(uint handle, Type componentType);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_SetTranslation(ulong entityID, ref Vector3 translation);
-
-        [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_GetRotation(ulong entityID, out Vector3 rotation);
+        internal extern static ulong Entity_FindEntityByName(string name);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_SetRotation(ulong entityID, ref Vector3 rotation);
+        internal extern static ulong[] Entity_FindEntitiesByName(string name);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_GetScale(ulong entityID, out Vector3 scale);
+        internal extern static object GetScriptInstance(ulong entityID);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void TransformComponent_SetScale(ulong entityID, ref Vector3 scale);
+        internal extern static unsafe TransformData* TransformComponent_GetData(uint handle, out uint* version);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void Rigidbody2DComponent_ApplyLinearImpulse(ulong entityID, ref Vector2 impulse,
+        internal extern static void Rigidbody2DComponent_ApplyLinearImpulse(uint handle, ref Vector2 impulse,
                                                                             ref Vector2 point, bool wake);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
-        internal extern static void Rigidbody2DComponent_ApplyLinearImpulseToCenter(ulong entityID, ref Vector2 impulse,
+        internal extern static void Rigidbody2DComponent_ApplyLinearImpulseToCenter(uint handle, ref Vector2 impulse,
                                                                                     bool wake);
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal extern static bool Input_IsKeyDown(KeyCode keycode);
@@ -1,6 +1,7 @@
 using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Runtime.InteropServices;
 using System.Text;
 using System.Threading.Tasks;
 
@@ -11,39 +12,33 @@ namespace Titan
         public Entity Entity { get; internal set; }
     }
 
+    // Same layout as the native TransformComponent
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct TransformData
+    {
+        public Vector3 Translation;
+        public Vector3 Rotation;
+        public Vector3 Scale;
+    }
+
     public class TransformComponent : Component
     {
-        public Vector3 Translation
+        public unsafe Vector3 Translation
         {
-            get {
-                InternalCalls.TransformComponent_GetTranslation(Entity.ID, out Vector3 translation);
-                return translation;
-            }
-            set {
-                InternalCalls.TransformComponent_SetTranslation(Entity.ID, ref value);
-            }
+            get { return Entity.Transform->Translation; }
+            set { Entity.Transform->Translation = value; }
         }
 
-        public Vector3 Rotation
+        public unsafe Vector3 Rotation
         {
-            get {
-                InternalCalls.TransformComponent_GetRotation(Entity.ID, out Vector3 rotation);
-                return rotation;
-            }
-            set {
-                InternalCalls.TransformComponent_SetRotation(Entity.ID, ref value);
-            }
+            get { return Entity.Transform->Rotation; }
+            set { Entity.Transform->Rotation = value; }
         }
 
-        public Vector3 Scale
+        public unsafe Vector3 Scale
         {
-            get {
-                InternalCalls.TransformComponent_GetScale(Entity.ID, out Vector3 scale);
-                return scale;
-            }
-            set {
-                InternalCalls.TransformComponent_SetScale(Entity.ID, ref value);
-            }
+            get { return Entity.Transform->Scale; }
+            set { Entity.Transform->Scale = value; }
         }
     }
 
@@ -51,12 +46,12 @@ namespace Titan
     {
         public void ApplyLinearImpulse(Vector2 impulse, Vector2 worldPosition, bool wake)
         {
-            InternalCalls.Rigidbody2DComponent_ApplyLinearImpulse(Entity.ID, ref impulse, ref worldPosition, wake);
+            InternalCalls.Rigidbody2DComponent_ApplyLinearImpulse(Entity.Handle, ref impulse, ref worldPosition, wake);
         }
 
         public void ApplyLinearImpulse(Vector2 impulse, bool wake)
         {
-            InternalCalls.Rigidbody2DComponent_ApplyLinearImpulseToCenter(Entity.ID, ref impulse, wake);
+            InternalCalls.Rigidbody2DComponent_ApplyLinearImpulseToCenter(Entity.Handle, ref impulse, wake);
         }
     }
 }
\ No newline at end of file
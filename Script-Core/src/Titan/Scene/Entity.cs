@@ -1,8 +1,17 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 
 namespace Titan
 {
+    // Scripts derive from Entity and define any of OnCreate(), OnUpdate(float ts), OnFixedUpdate(float ts) and
+    // OnDestroy(), which the engine finds by name. A script can opt into batching by also defining
+    //     static void OnUpdateBatch(MyScript[] scripts, float ts)
+    // which is then called once per frame with every instance of the class in place of OnUpdate on each of them,
+    // and likewise OnFixedUpdateBatch for OnFixedUpdate.
+    // Collisions are delivered by overriding OnCollisionEnter and OnCollisionExit. The engine collects the contacts
+    // of a physics step and passes all of them in one call once the step is done.
     public class Entity
     {
         protected Entity() { ID = 0; }
@@ -11,54 +20,111 @@ namespace Titan
 
         public readonly ulong ID;
 
-        public Vector3 Translation
+        // Native entity handle, resolved from the ID on first use
+        private uint m_Handle;
+        private bool m_HasHandle;
+
+        // The handle and transform pointers belong to the scene that was running when they were fetched. They are
+        // dropped once the engine starts or stops a runtime scene, so an Entity kept in a static field never reaches
+        // into a scene that is gone.
+        private static unsafe uint* s_SceneGeneration;
+        private uint m_Generation;
+
+        private unsafe void DropStaleCache()
         {
-            get {
-                InternalCalls.TransformComponent_GetTranslation(ID, out Vector3 result);
-                return result;
-            }
-            set {
-                InternalCalls.TransformComponent_SetTranslation(ID, ref value);
+            if (s_SceneGeneration == null)
+                s_SceneGeneration = InternalCalls.Scene_GetGeneration();
+
+            if (m_Generation != *s_SceneGeneration)
+            {
+                m_Generation = *s_SceneGeneration;
+                m_HasHandle = false;
+                m_Transform = null;
+                m_TransformVersion = null;
             }
         }
 
-        public Vector3 Rotation
+        internal uint Handle
         {
             get {
-                InternalCalls.TransformComponent_GetRotation(ID, out Vector3 result);
-                return result;
-            }
-            set {
-                InternalCalls.TransformComponent_SetRotation(ID, ref value);
+                DropStaleCache();
+                if (!m_HasHandle)
+                {
+                    m_Handle = InternalCalls.Entity_GetHandle(ID);
+                    m_HasHandle = true;
+                }
+                return m_Handle;
             }
         }
 
-        public Vector3 Scale
+        // Points straight at the native TransformComponent. Fetched again once the scene bumps the storage version,
+        // which it does whenever transforms may have moved.
+        private unsafe TransformData* m_Transform;
+        private unsafe uint* m_TransformVersion;
+        private uint m_CachedTransformVersion;
+
+        internal unsafe TransformData* Transform
         {
             get {
-                InternalCalls.TransformComponent_GetScale(ID, out Vector3 result);
-                return result;
-            }
-            set {
-                InternalCalls.TransformComponent_SetScale(ID, ref value);
+                DropStaleCache();
+                if (m_Transform == null || *m_TransformVersion != m_CachedTransformVersion)
+                {
+                    m_Transform = InternalCalls.TransformComponent_GetData(Handle, out m_TransformVersion);
+                    if (m_Transform == null)
+                    {
+                        m_HasHandle = false;
+                        throw new InvalidOperationException($"Entity {ID} no longer exists");
+                    }
+                    m_CachedTransformVersion = *m_TransformVersion;
+                }
+                return m_Transform;
             }
         }
 
+        public unsafe Vector3 Translation
+        {
+            get { return Transform->Translation; }
+            set { Transform->Translation = value; }
+        }
+
+        public unsafe Vector3 Rotation
+        {
+            get { return Transform->Rotation; }
+            set { Transform->Rotation = value; }
+        }
+
+        public unsafe Vector3 Scale
+        {
+            get { return Transform->Scale; }
+            set { Transform->Scale = value; }
+        }
+
         public bool HasComponent<T>()
             where T : Component, new()
         {
             Type componentType = typeof(T);
-            return InternalCalls.Entity_HasComponent(ID, componentType);
+            return InternalCalls.Entity_HasComponent(Handle, componentType);
         }
 
+        // Wrappers are created once per component type, so fetching components every frame does not allocate
+        private Dictionary<Type, Component> m_Components;
+
         public T GetComponent<T>()
             where T : Component, new()
         {
             if (!HasComponent<T>())
                 return null;
 
-            T component = new T() { Entity = this };
-            return component;
+            if (m_Components == null)
+                m_Components = new Dictionary<Type, Component>();
+
+            Type componentType = typeof(T);
+            if (!m_Components.TryGetValue(componentType, out Component component))
+            {
+                component = new T() { Entity = this };
+                m_Components.Add(componentType, component);
+            }
+            return (T)component;
         }
 
         public Entity FindEntityByName(string name)
@@ -70,12 +136,55 @@ namespace Titan
             return new Entity(entityID);
         }
 
+        public Entity[] FindEntitiesByName(string name)
+        {
+            ulong[] entityIDs = InternalCalls.Entity_FindEntitiesByName(name);
+            Entity[] entities = new Entity[entityIDs.Length];
+            for (int i = 0; i < entityIDs.Length; i++)
+                entities[i] = new Entity(entityIDs[i]);
+
+            return entities;
+        }
+
         public T As<T>()
             where T : Entity, new()
         {
             object instance = InternalCalls.GetScriptInstance(ID);
             return instance as T;
         }
+
+        protected virtual void OnCollisionEnter(Entity other) {}
+        protected virtual void OnCollisionExit(Entity other) {}
+
+        // Called by the engine after each physics step. others[i] is null when the other entity runs no script.
+        // A throwing handler is logged so the remaining contacts are still delivered.
+        private static unsafe void DispatchCollisions(Entity[] entities, Entity[] others, ContactData* contacts,
+                                                      int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                Entity other = others[i] ?? new Entity(contacts[i].OtherID);
+                try
+                {
+                    if (contacts[i].Began != 0)
+                        entities[i].OnCollisionEnter(other);
+                    else
+                        entities[i].OnCollisionExit(other);
+                }
+                catch (Exception e)
+                {
+                    Log.Error(e.ToString());
+                }
+            }
+        }
+    }
+
+    // Same layout as the native ScriptContact
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct ContactData
+    {
+        public ulong OtherID;
+        public uint Began;
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include <Titan.h>
+#include <Titan/Scripting/ScriptEngine.h>
+#include "ServerLayer.h"
+
+namespace Titan
+{
+    class TitanServer : public Application
+    {
+    public:
+        TitanServer(const ServerSettings& settings) : Application("Titan Server", true)
+        {
+            PushLayer(new ServerLayer(settings));
+        }
+        ~TitanServer() {}
+    };
+
+    static void PrintUsage()
+    {
+        fmt::print("Usage: TitanServer <scene.titan|scene.titanbin> [--rate <hz>] [--frames <count>] "
+                   "[--report <frames>] [--script-aot <none|normal|hybrid>] [--spawn <count> <class>]\n");
+    }
+} // namespace Titan
+
+// No EntryPoint.h, the server needs the command line
+int main(int argc, char** argv)
+{
+    Titan::ServerSettings settings;
+
+    // std::stof and std::stoul throw std::invalid_argument or std::out_of_range on a bad number
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+            if (arg == "--rate" && i + 1 < argc)
+                settings.TickRate = std::stof(argv[++i]);
+            else if (arg == "--frames" && i + 1 < argc)
+                settings.FrameCount = (uint32_t)std::stoul(argv[++i]);
+            else if (arg == "--report" && i + 1 < argc)
+                settings.ReportInterval = (std::max)((uint32_t)std::stoul(argv[++i]), 1u);
+            else if (arg == "--spawn" && i + 2 < argc)
+            {
+                settings.SpawnCount = (uint32_t)std::stoul(argv[++i]);
+                settings.SpawnClass = argv[++i];
+            }
+            else if (arg == "--script-aot" && i + 1 < argc)
+            {
+                std::string_view mode = argv[++i];
+                if (mode == "normal")
+                    Titan::ScriptEngine::SetAotMode(Titan::ScriptAotMode::Normal);
+                else if (mode == "hybrid")
+                    Titan::ScriptEngine::SetAotMode(Titan::ScriptAotMode::Hybrid);
+                else if (mode != "none")
+                {
+                    Titan::PrintUsage();
+                    return 1;
+                }
+            }
+            else if (settings.ScenePath.empty() && !arg.starts_with("--"))
+                settings.ScenePath = arg;
+            else
+            {
+                Titan::PrintUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        Titan::PrintUsage();
+        return 1;
+    }
+
+    if (settings.ScenePath.empty())
+    {
+        Titan::PrintUsage();
+        return 1;
+    }
+
+    Titan::Log::Init();
+
+    Titan::Application* app = new Titan::TitanServer(settings);
+    app->Run();
+    Titan::DeleteApplication(app);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "ServerLayer.h"
+#include <Titan/Scripting/ScriptEngine.h>
+#include <thread>
+
+namespace Titan
+{
+
+    ServerLayer::ServerLayer(const ServerSettings& settings) : Layer("ServerLayer"), m_Settings(settings)
+    {
+        m_UpdateMillis.reserve(m_Settings.ReportInterval);
+    }
+
+    void ServerLayer::OnAttach()
+    {
+        m_Scene = CreateRef<Scene>();
+        SceneSerializer serializer(m_Scene);
+        const std::string scenePath = m_Settings.ScenePath.string();
+        const bool loaded = SceneSerializer::IsRuntimeScene(m_Settings.ScenePath)
+                                ? serializer.DeserializeRuntime(scenePath)
+                                : serializer.Deserialize(scenePath);
+        if (!loaded)
+        {
+            TI_ERROR("Could not load scene {}", scenePath);
+            m_Scene = nullptr;
+            Application::GetInstance()->Close();
+            return;
+        }
+
+        if (m_Settings.SpawnCount)
+        {
+            if (!ScriptEngine::EntityClassExists(m_Settings.SpawnClass))
+                TI_WARN("Script class {} does not exist, spawned entities will not run it", m_Settings.SpawnClass);
+
+            for (uint32_t i = 0; i < m_Settings.SpawnCount; i++)
+                m_Scene->CreateEntity().AddComponent<ScriptComponent>().ClassName = m_Settings.SpawnClass;
+            fmt::print("Spawned {} entities running {}\n", m_Settings.SpawnCount, m_Settings.SpawnClass);
+        }
+
+        m_Scene->OnRuntimeStart();
+
+        fmt::print("Running {} {}\n", m_Settings.ScenePath.string(),
+                   m_Settings.TickRate > 0.0f ? fmt::format("at {} Hz", m_Settings.TickRate) : "uncapped");
+
+        m_ReportTimer.Reset();
+        m_RunTimer.Reset();
+        ScriptEngine::ResetStats();
+        m_NextTick = std::chrono::steady_clock::now();
+    }
+
+    // Not in OnDetach, layers are only detached after the script engine shut down
+    void ServerLayer::Finish()
+    {
+        if (!m_UpdateMillis.empty())
+            Report();
+
+        m_Scene->OnRuntimeStop();
+        m_Scene = nullptr;
+        fmt::print("Ran {} frames in {:.2f}s\n", m_Frame, m_RunTimer.Elapsed());
+
+        Application::GetInstance()->Close();
+    }
+
+    void ServerLayer::OnUpdate(Timestep ts)
+    {
+        if (!m_Scene)
+            return;
+
+        Timer timer;
+        m_Scene->OnUpdateRuntime(ts);
+        m_UpdateMillis.push_back(timer.ElapsedMillis());
+        m_Frame++;
+
+        if (m_UpdateMillis.size() >= m_Settings.ReportInterval)
+            Report();
+
+        if (m_Settings.FrameCount && m_Frame >= m_Settings.FrameCount)
+        {
+            Finish();
+            return;
+        }
+
+        WaitForNextTick();
+    }
+
+    void ServerLayer::Report()
+    {
+        std::vector<float> sorted = m_UpdateMillis;
+        std::sort(sorted.begin(), sorted.end());
+
+        float total = 0.0f;
+        for (float millis : sorted)
+            total += millis;
+
+        const size_t p99 = (std::min)(sorted.size() - 1, sorted.size() * 99 / 100);
+        const float elapsed = m_ReportTimer.Elapsed();
+        fmt::print("frame {:>8} | update avg {:.3f}ms min {:.3f}ms p99 {:.3f}ms max {:.3f}ms | {:.0f} frames/s\n",
+                   m_Frame, total / sorted.size(), sorted.front(), sorted[p99], sorted.back(),
+                   sorted.size() / elapsed);
+
+        for (const auto& system : m_Scene->GetSystems())
+            fmt::print("    {:<20} {:.3f}ms\n", system->GetName(), system->GetLastMillis());
+
+        // Per update call since the runtime started, with an empty OnUpdate this is the cost of dispatching it
+        for (const auto& timing : ScriptEngine::GetClassTimings())
+            fmt::print("        {:<24} avg {:.3f}ms min {:.3f}ms max {:.3f}ms | {:.3f}us/update\n", timing.Name,
+                       timing.AvgFrameMillis, timing.MinFrameMillis, timing.MaxFrameMillis,
+                       timing.UpdateCalls ? timing.UpdateMillis * 1000.0f / timing.UpdateCalls : 0.0f);
+
+#ifdef TI_ENABLE_SCRIPT_PROFILING
+        const auto scriptStats = ScriptEngine::GetStats();
+        fmt::print("    managed {:.1f} allocs/frame {:.0f} bytes/frame | {} GCs {:.3f}ms\n",
+                   (float)scriptStats.Total.Allocations / sorted.size(),
+                   (float)scriptStats.Total.AllocatedBytes / sorted.size(), scriptStats.Total.GCCount,
+                   scriptStats.Total.GCMillis);
+        for (const auto& [name, classStats] : scriptStats.Classes)
+            fmt::print("        {:<24} {:.0f} bytes/frame {} GCs\n", name,
+                       (float)classStats.AllocatedBytes / sorted.size(), classStats.GCCount);
+        ScriptEngine::ResetStats();
+#endif
+
+        m_UpdateMillis.clear();
+        m_ReportTimer.Reset();
+    }
+
+    void ServerLayer::WaitForNextTick()
+    {
+        if (m_Settings.TickRate <= 0.0f)
+            return;
+
+        // Deadlines advance by whole ticks, so sleeping does not let the rate drift. A tick that runs past its
+        // deadline restarts the schedule from now, the missed ticks are dropped rather than run back to back.
+        const auto tick = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(1.0f / m_Settings.TickRate));
+        m_NextTick += tick;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (m_NextTick < now)
+            m_NextTick = now;
+        else
+            std::this_thread::sleep_until(m_NextTick);
+    }
+
+} // namespace Titan
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Titan.h>
+
+namespace Titan
+{
+
+    struct ServerSettings
+    {
+        std::filesystem::path ScenePath;
+        float TickRate = 0.0f;         // Updates per second, 0 runs uncapped
+        uint32_t FrameCount = 0;       // Quit after this many frames, 0 runs until killed
+        uint32_t ReportInterval = 600; // Frames between timing reports
+        // Entities running SpawnClass added to the scene before it starts, to measure script dispatch at scale
+        uint32_t SpawnCount = 0;
+        std::string SpawnClass;
+    };
+
+    // Runs one scene in play mode without window or renderer and reports how long its updates take
+    class ServerLayer : public Layer
+    {
+    public:
+        ServerLayer(const ServerSettings& settings);
+
+        virtual void OnAttach() override;
+        virtual void OnUpdate(Timestep ts) override;
+
+    private:
+        void Report();
+        void WaitForNextTick();
+        void Finish();
+
+    private:
+        ServerSettings m_Settings;
+        Ref<Scene> m_Scene;
+
+        uint32_t m_Frame = 0;
+        std::vector<float> m_UpdateMillis; // Since the last report
+        Timer m_ReportTimer;
+        Timer m_RunTimer;
+
+        std::chrono::steady_clock::time_point m_NextTick;
+    };
+
+} // namespace Titan
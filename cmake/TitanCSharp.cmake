@@ -0,0 +1,41 @@
+# ---- C# Assemblies ----
+# Only the Visual Studio generators know the CSharp language. Everywhere else (Ninja, Makefiles, Linux CI) the
+# assemblies are built with the Mono compiler against the class library the engine embeds.
+if(CMAKE_GENERATOR MATCHES "Visual Studio")
+    set(TI_CSHARP_NATIVE ON)
+else()
+    set(TI_CSHARP_NATIVE OFF)
+    find_program(TI_CSHARP_COMPILER NAMES mcs csc REQUIRED)
+endif()
+
+set(TI_CSHARP_FRAMEWORK_DIR "${CMAKE_SOURCE_DIR}/Runtime/mono/lib/mono/4.5" CACHE PATH
+    "Class library the C# assemblies are compiled against when not using Visual Studio")
+
+# ti_add_csharp_library(<target> OUTPUT <dll> SOURCES <files...> REFERENCES <assemblies...>)
+# Builds the assembly with TI_CSHARP_COMPILER. References without a path are taken from the embedded class library.
+function(ti_add_csharp_library target)
+    cmake_parse_arguments(ARG "" "OUTPUT" "SOURCES;REFERENCES" ${ARGN})
+
+    set(references "-r:${TI_CSHARP_FRAMEWORK_DIR}/mscorlib.dll")
+    set(dependencies "")
+    foreach(reference ${ARG_REFERENCES})
+        if(IS_ABSOLUTE "${reference}")
+            list(APPEND references "-r:${reference}")
+            list(APPEND dependencies "${reference}")
+        else()
+            list(APPEND references "-r:${TI_CSHARP_FRAMEWORK_DIR}/${reference}.dll")
+        endif()
+    endforeach()
+
+    get_filename_component(outputDir "${ARG_OUTPUT}" DIRECTORY)
+    add_custom_command(
+        OUTPUT "${ARG_OUTPUT}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${outputDir}"
+        COMMAND "${TI_CSHARP_COMPILER}" -noconfig -nostdlib -target:library -unsafe -debug ${references}
+            "-out:${ARG_OUTPUT}" ${ARG_SOURCES}
+        DEPENDS ${ARG_SOURCES} ${dependencies}
+        COMMENT "Building C# assembly ${target}"
+        VERBATIM
+    )
+    add_custom_target(${target} ALL DEPENDS "${ARG_OUTPUT}")
+endfunction()